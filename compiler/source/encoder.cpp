@@ -1,5 +1,6 @@
 #include "encoder.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -99,6 +100,20 @@ bool Encoder::encode(const SymbolList& symbolList, const TypeCollection& collect
 		}
 	}
 
+	// the type ids are hashes of the names, two types must not share one
+	std::map<unsigned long long, std::string> ids;
+	for (const auto& [name, symbol] : symbolTable)
+	{
+		if (symbol == SymbolType::S_enum) continue;
+
+		const auto& it = ids.insert(std::make_pair(StringUtil::hash(name), name));
+		if (!it.second)
+		{
+			std::cout << "The types " << it.first->second << " and " << name << " have the same type id" << std::endl;
+			return false;
+		}
+	}
+
 	// enums
 	for (TypeEnum* const eEnum : enums)
 	{
@@ -158,6 +173,14 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	const bool isNativeClass = symbolTable.find(type.name)->second == SymbolType::S_nativeClass;
 	bool hasForwardDeclaration = false;
 
+	// serialized properties, used for the tagged binary format and the flat slots
+	std::vector<Property> fields;
+	if (!collectFields(symbolTable, collection, type, isNativeClass, fields)) return false;
+
+	// CLASS(Tracked) types derive from reflect::ITrackedType
+	const auto& trackedIt = type.meta.find("Tracked");
+	const bool isTracked = !isNativeClass && trackedIt != type.meta.end() && trackedIt->second != "false";
+
 	// header
 	const std::string forward_keyword = type.isStruct ? "struct" : "class";
 	
@@ -219,16 +242,69 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	if (!isNativeClass) 
 	{
 		headerBuffer.push_line("    static IType* const instantiate();");
+		headerBuffer.push_line("    static std::shared_ptr<IType> instantiate_shared(std::pmr::memory_resource* const resource);");
 	}
+	headerBuffer.push_line("    static reflect::type_id_t id();");
+	headerBuffer.push_line("    static std::uint64_t schema();");
 	headerBuffer.push_line("    static const reflect::meta_t& meta();");
 	headerBuffer.push_line("    static const char* const name();");
 	headerBuffer.push_line("    static const reflect::properties_t& properties();");
 	headerBuffer.push_line("    static std::size_t size();");
 	headerBuffer.push_line("");
-	headerBuffer.push_line("    static void from_string(const std::string& str, ", type.name, "& type);");
-	headerBuffer.push_line("    static std::string to_string(const ", type.name, "& type);");
+	headerBuffer.push_line("    static void from_string(const std::string& str, ", type.name, "& type, const reflect::encoding::ByteFormat& format = {});");
+	headerBuffer.push_line("    static void from_bytes(const reflect::encoding::ByteView& view, ", type.name, "& type, const reflect::encoding::ByteFormat& format = {});");
+	headerBuffer.push_line("    static void read(reflect::encoding::InputByteStream& stream, ", type.name, "& type);");
+	headerBuffer.push_line("    static void read_body(reflect::encoding::InputByteStream& stream, ", type.name, "& type);");
+	headerBuffer.push_line("    static void read_field(reflect::encoding::InputByteStream& stream, ", type.name, "& type, const std::uint32_t tag);");
+	headerBuffer.push_line("    static std::string to_string(const ", type.name, "& type, const reflect::encoding::ByteFormat& format = {});");
+	headerBuffer.push_line("    static void write(reflect::encoding::OutputByteStream& stream, const ", type.name, "& type);");
+	headerBuffer.push_line("    static std::size_t binary_size(const ", type.name, "& type, const reflect::encoding::ByteFormat& format = {});");
+	headerBuffer.push_line("    static bool write_delta(const ", type.name, "& baseline, const ", type.name, "& type, reflect::encoding::OutputByteStream& stream);");
+	headerBuffer.push_line("    static void apply_delta(const ", type.name, "& baseline, reflect::encoding::InputByteStream& stream, ", type.name, "& type);");
 	headerBuffer.push_line("    static void from_json(const std::string& json, ", type.name, "& type);");
+	headerBuffer.push_line("    static void read_json(reflect::encoding::json::Reader& reader, ", type.name, "& type);");
 	headerBuffer.push_line("    static std::string to_json(const ", type.name, "& type, const std::string& offset = \"\");");
+	headerBuffer.push_line("    static void to_json(reflect::encoding::json::Writer& writer, const ", type.name, "& type);");
+	headerBuffer.push_line("");
+	if (isTracked)
+	{
+		headerBuffer.push_line("    // dirty bits of the properties");
+		headerBuffer.push_line("    struct Dirty");
+		headerBuffer.push_line("    {");
+		for (std::size_t i = 0; i < fields.size(); ++i)
+		{
+			headerBuffer.push_line("        static constexpr std::uint64_t ", fields[i].name, " = reflect::ITrackedType::dirty_bit(", i, ");");
+		}
+		headerBuffer.push_line("    };");
+		headerBuffer.push_line("");
+		for (const Property& field : fields)
+		{
+			headerBuffer.push_line("    static void set_", field.name, "(", type.name, "& type, ", field.type, " value);");
+		}
+		headerBuffer.push_line("");
+	}
+	headerBuffer.push_line("    typedef reflect::encoding::LazyView<", type.name, "> LazyView;");
+	headerBuffer.push_line("");
+	headerBuffer.push_line("    static reflect::encoding::ByteBuffer to_flat(const ", type.name, "& type);");
+	headerBuffer.push_line("    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const ", type.name, "& type);");
+	headerBuffer.push_line("");
+	headerBuffer.push_line("    // read-only accessors over a flat buffer");
+	headerBuffer.push_line("    struct Flat");
+	headerBuffer.push_line("    {");
+	headerBuffer.push_line("        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}");
+	headerBuffer.push_line("        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}");
+	headerBuffer.push_line("");
+	headerBuffer.push_line("        bool isValid() const { return m_table.isValid(); }");
+	for (const Property& field : fields)
+	{
+		const std::string accessor = encodeFlatAccessorType(symbolTable, field.type);
+		if (accessor.empty()) continue;
+
+		headerBuffer.push_line("        ", accessor, " ", field.name, "() const;");
+	}
+	headerBuffer.push_line("");
+	headerBuffer.push_line("        reflect::encoding::FlatTable m_table;");
+	headerBuffer.push_line("    };");
 	if (!isNativeClass)
 	{
 		headerBuffer.push_line("");
@@ -237,6 +313,12 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	headerBuffer.push_line("};");
 	headerBuffer.push_line("");
 
+	std::string schema;
+	for (const Property& field : fields)
+	{
+		schema.append(field.name).append(" ").append(field.type).append(";");
+	}
+
 	// source
 	if (!isNativeClass)
 	{
@@ -245,6 +327,12 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 		sourceBuffer.push_line("    return dynamic_cast<IType*>(new ", type.name, "());");
 		sourceBuffer.push_line("}");
 		sourceBuffer.push_line("");
+		sourceBuffer.push_line("std::shared_ptr<IType> reflect::Type<", type.name, ">::instantiate_shared(std::pmr::memory_resource* const resource)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    if (resource == nullptr) return std::make_shared<", type.name, ">();");
+		sourceBuffer.push_line("    return std::allocate_shared<", type.name, ">(std::pmr::polymorphic_allocator<", type.name, ">(resource));");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("");
 	}
 	sourceBuffer.push_line("const reflect::meta_t& reflect::Type<", type.name, ">::meta()");
 	sourceBuffer.push_line("{");
@@ -256,6 +344,8 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	sourceBuffer.push_line("    };");
 	sourceBuffer.push_line("    return s_meta;");
 	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("reflect::type_id_t reflect::Type<", type.name, ">::id() { return 0x", std::hex, StringUtil::hash(type.name), std::dec, "ull; }");
+	sourceBuffer.push_line("std::uint64_t reflect::Type<", type.name, ">::schema() { return 0x", std::hex, StringUtil::hash(schema), std::dec, "ull; }");
 	sourceBuffer.push_line("const char* const reflect::Type<", type.name, ">::name() { return \"", type.name, "\"; }");
 	sourceBuffer.push_line("");
 	sourceBuffer.push_line("const reflect::properties_t& Type<", type.name, ">::properties()");
@@ -264,7 +354,7 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	// look for parent classes
 	bool has_parent = false;
 	std::string parent_name = type.parent;
-	while (parent_name != "IType" && !isNativeClass)
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
 	{
 		has_parent = true;
 		TypeClass* const parentClass = collection.findClass(parent_name);
@@ -299,28 +389,56 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	sourceBuffer.push_line("    return sizeof(", type.name, ");");
 	sourceBuffer.push_line("}");
 	sourceBuffer.push_line("");
-	sourceBuffer.push_line("void reflect::Type<", type.name, ">::from_string(const std::string& str, ", type.name, "& type)");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::from_string(const std::string& str, ", type.name, "& type, const reflect::encoding::ByteFormat& format)");
 	sourceBuffer.push_line("{");
-	sourceBuffer.push_line("    reflect::encoding::ByteBuffer buffer;");
-	sourceBuffer.push_line("    std::transform(");
-	sourceBuffer.push_line("        std::begin(str),");
-	sourceBuffer.push_line("        std::end(str),");
-	sourceBuffer.push_line("        std::back_inserter(buffer),");
-	sourceBuffer.push_line("        [](const char c)");
+	sourceBuffer.push_line("    from_bytes(str, type, format);");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::from_bytes(const reflect::encoding::ByteView& view, ", type.name, "& type, const reflect::encoding::ByteFormat& format)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    reflect::encoding::InputByteStream stream(view, format);");
+	sourceBuffer.push_line("    read(stream, type);");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::read(reflect::encoding::InputByteStream& stream, ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    reflect::type_id_t _id{ 0 };");
+	sourceBuffer.push_line("    stream.readFixed(_id);");
+	sourceBuffer.push_line("    if (_id != id()) return;");
+	sourceBuffer.push_line("    read_body(stream, type);");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::read_body(reflect::encoding::InputByteStream& stream, ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	if (isTracked)
+	{
+		// every decoding path goes through the static functions, the cached forms of the object are stale
+		sourceBuffer.push_line("    type.invalidate_cache();");
+	}
+	sourceBuffer.push_line("    if (stream.getFormat().tagged)");
+	sourceBuffer.push_line("    {");
+	sourceBuffer.push_line("        std::uint64_t _schema{ 0 };");
+	sourceBuffer.push_line("        std::size_t _fields{ 0 };");
+	sourceBuffer.push_line("        stream.readFixed(_schema);");
+	sourceBuffer.push_line("        stream >> _fields;");
+	sourceBuffer.push_line("        // the writer had a different schema, match the fields by tag and skip the unknown ones");
+	sourceBuffer.push_line("        if (_schema != schema())");
 	sourceBuffer.push_line("        {");
-	sourceBuffer.push_line("            return std::byte(c);");
+	sourceBuffer.push_line("            for (std::size_t _i = 0; _i < _fields; ++_i)");
+	sourceBuffer.push_line("            {");
+	sourceBuffer.push_line("                std::uint32_t _tag{ 0 };");
+	sourceBuffer.push_line("                const std::size_t field = stream.beginField(_tag);");
+	sourceBuffer.push_line("                read_field(stream, type, _tag);");
+	sourceBuffer.push_line("                stream.endField(field);");
+	sourceBuffer.push_line("            }");
+	sourceBuffer.push_line("            return;");
 	sourceBuffer.push_line("        }");
-	sourceBuffer.push_line("    );");
-	sourceBuffer.push_line("    ");
-	sourceBuffer.push_line("    reflect::encoding::InputByteStream stream(buffer);");
-	sourceBuffer.push_line("    std::string _name;");
-	sourceBuffer.push_line("    stream >> _name;");
-	sourceBuffer.push_line("    if (_name != name()) return;");
+	sourceBuffer.push_line("    }");
 	sourceBuffer.push_line("    ");
 	// look for parent classes
 	has_parent = false;
 	parent_name = type.parent;
-	while (parent_name != "IType" && !isNativeClass)
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
 	{
 		has_parent = true;
 		TypeClass* const parentClass = collection.findClass(parent_name);
@@ -334,7 +452,7 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 		for (const Property& property : parentClass->properties)
 		{
 			const bool serialize = false;
-			std::string temp = encodePropertySerialization("    ", symbolTable, serialize, property);
+			std::string temp = encodeField("    ", symbolTable, serialize, property);
 			if (!temp.empty())
 				sourceBuffer.push_line(temp);
 		}
@@ -348,22 +466,55 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	for (const Property& property : type.properties)
 	{
 		const bool serialize = false;
-		std::string temp = encodePropertySerialization("    ", symbolTable, serialize, property);
+		std::string temp = encodeField("    ", symbolTable, serialize, property);
 		if (!temp.empty())
 			sourceBuffer.push_line(temp);
 	}
 	sourceBuffer.push_line("}");
 	sourceBuffer.push_line("");
-	sourceBuffer.push_line("std::string reflect::Type<", type.name, ">::to_string(const ", type.name, "& type)");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::read_field(reflect::encoding::InputByteStream& stream, ", type.name, "& type, const std::uint32_t tag)");
+	sourceBuffer.push_line("{");
+	if (isTracked)
+	{
+		sourceBuffer.push_line("    type.invalidate_cache();");
+	}
+	sourceBuffer.push_line("    switch (tag)");
+	sourceBuffer.push_line("    {");
+	for (const Property& field : fields)
+	{
+		const bool serialize = false;
+		sourceBuffer.push_line("    case 0x", std::hex, fieldTag(field), std::dec, "u:");
+		sourceBuffer.push_line("    {");
+		sourceBuffer.push_line(encodePropertySerialization("        ", symbolTable, serialize, field));
+		sourceBuffer.push_line("        break;");
+		sourceBuffer.push_line("    }");
+	}
+	sourceBuffer.push_line("    default: break;");
+	sourceBuffer.push_line("    }");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("std::string reflect::Type<", type.name, ">::to_string(const ", type.name, "& type, const reflect::encoding::ByteFormat& format)");
 	sourceBuffer.push_line("{");
 	sourceBuffer.push_line("    reflect::encoding::ByteBuffer buffer;");
-	sourceBuffer.push_line("    reflect::encoding::OutputByteStream stream(buffer);");
-	sourceBuffer.push_line("    stream << name();");
+	sourceBuffer.push_line("    reflect::encoding::OutputByteStream stream(buffer, format);");
+	sourceBuffer.push_line("    stream.reserve(binary_size(type, format));");
+	sourceBuffer.push_line("    write(stream, type);");
+	sourceBuffer.push_line("    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::write(reflect::encoding::OutputByteStream& stream, const ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    stream.writeFixed(id());");
+	sourceBuffer.push_line("    if (stream.getFormat().tagged)");
+	sourceBuffer.push_line("    {");
+	sourceBuffer.push_line("        stream.writeFixed(schema());");
+	sourceBuffer.push_line("        stream << std::size_t{ ", fields.size(), " };");
+	sourceBuffer.push_line("    }");
 	sourceBuffer.push_line("    ");
 	// look for parent classes
 	has_parent = false;
 	parent_name = type.parent;
-	while (parent_name != "IType" && !isNativeClass)
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
 	{
 		has_parent = true;
 		TypeClass* const parentClass = collection.findClass(parent_name);
@@ -377,7 +528,7 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 		for (const Property& property : parentClass->properties)
 		{
 			const bool serialize = true;
-			std::string temp = encodePropertySerialization("    ", symbolTable, serialize, property);
+			std::string temp = encodeField("    ", symbolTable, serialize, property);
 			if (!temp.empty())
 				sourceBuffer.push_line(temp);
 		}
@@ -391,32 +542,24 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	for (const Property& property : type.properties)
 	{
 		const bool serialize = true;
-		std::string temp = encodePropertySerialization("    ", symbolTable, serialize, property);
+		std::string temp = encodeField("    ", symbolTable, serialize, property);
 		if (!temp.empty())
 			sourceBuffer.push_line(temp);
 	}
-	sourceBuffer.push_line("    ");
-	sourceBuffer.push_line("    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());");
 	sourceBuffer.push_line("}");
 	sourceBuffer.push_line("");
-	sourceBuffer.push_line("void reflect::Type<", type.name, ">::from_json(const std::string& json, ", type.name, "& type)");
+	sourceBuffer.push_line("std::size_t reflect::Type<", type.name, ">::binary_size(const ", type.name, "& type, const reflect::encoding::ByteFormat& format)");
 	sourceBuffer.push_line("{");
-	sourceBuffer.push_line("    std::string src{ reflect::encoding::json::Deserializer::trim(json, reflect::encoding::json::Deserializer::space) };");
-	sourceBuffer.push_line("    ");
-	sourceBuffer.push_line("    size_t index = 0;");
-	sourceBuffer.push_line("    std::string key;");
-	sourceBuffer.push_line("    while ((index = reflect::encoding::json::Deserializer::next_key(src, key)) != std::string::npos)");
+	sourceBuffer.push_line("    std::size_t size = sizeof(reflect::type_id_t);");
+	sourceBuffer.push_line("    if (format.tagged)");
 	sourceBuffer.push_line("    {");
-	sourceBuffer.push_line("        src = src.substr(index + 2);");
-	sourceBuffer.push_line("        src = reflect::encoding::json::Deserializer::ltrim(src, reflect::encoding::json::Deserializer::space);");
-	sourceBuffer.push_line("        std::string value;");
-	sourceBuffer.push_line("        index = reflect::encoding::json::Deserializer::next_value(src, value);");
-	sourceBuffer.push_line("        if (index != std::string::npos)");
-	sourceBuffer.push_line("        {");
+	sourceBuffer.push_line("        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ ", fields.size(), " }, format);");
+	sourceBuffer.push_line("    }");
+	sourceBuffer.push_line("    ");
 	// look for parent classes
 	has_parent = false;
 	parent_name = type.parent;
-	while (parent_name != "IType" && !isNativeClass)
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
 	{
 		has_parent = true;
 		TypeClass* const parentClass = collection.findClass(parent_name);
@@ -426,11 +569,10 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 			return false;
 		}
 
-		sourceBuffer.push_line("            // Parent class ", parent_name, " properties");
+		sourceBuffer.push_line("    // Parent class ", parent_name, " properties");
 		for (const Property& property : parentClass->properties)
 		{
-			const bool serialize = false;
-			std::string temp = encodePropertySerializationToJson("            ", symbolTable, serialize, property);
+			std::string temp = encodeFieldSize("    ", symbolTable, property);
 			if (!temp.empty())
 				sourceBuffer.push_line(temp);
 		}
@@ -439,30 +581,205 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 	}
 	if (has_parent)
 	{
-		sourceBuffer.push_line("            // Properties");
+		sourceBuffer.push_line("    // Properties");
 	}
 	for (const Property& property : type.properties)
 	{
-		const bool serialize = false;
-		std::string temp = encodePropertySerializationToJson("            ", symbolTable, serialize, property);
+		std::string temp = encodeFieldSize("    ", symbolTable, property);
 		if (!temp.empty())
 			sourceBuffer.push_line(temp);
 	}
-	sourceBuffer.push_line("            src = src.substr(index + 1);");
-	sourceBuffer.push_line("        }");
-	sourceBuffer.push_line("        else break;");
-	sourceBuffer.push_line("    };");
+	sourceBuffer.push_line("    ");
+	sourceBuffer.push_line("    return size;");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	const std::size_t maskSize = std::max<std::size_t>(1, (fields.size() + 7) / 8);
+	sourceBuffer.push_line("bool reflect::Type<", type.name, ">::write_delta(const ", type.name, "& baseline, const ", type.name, "& type, reflect::encoding::OutputByteStream& stream)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    std::uint8_t _mask[", maskSize, "] = {};");
+	sourceBuffer.push_line("    const std::size_t _block = stream.beginBlock();");
+	sourceBuffer.push_line("    const std::size_t _position = stream.getPosition();");
+	sourceBuffer.push_line("    stream.writeArray(_mask, ", maskSize, ");");
+	if (fields.empty())
+	{
+		sourceBuffer.push_line("    static_cast<void>(baseline);");
+		sourceBuffer.push_line("    static_cast<void>(type);");
+	}
+	for (std::size_t index = 0; index < fields.size(); ++index)
+	{
+		sourceBuffer.push_line(encodeDeltaField("    ", symbolTable, collection, true, fields[index], index));
+	}
+	sourceBuffer.push_line("    stream.patchBytes(_position, _mask, ", maskSize, ");");
+	sourceBuffer.push_line("    stream.endBlock(_block);");
+	sourceBuffer.push_line("    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::apply_delta(const ", type.name, "& baseline, reflect::encoding::InputByteStream& stream, ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	if (isTracked)
+	{
+		sourceBuffer.push_line("    type.invalidate_cache();");
+	}
+	sourceBuffer.push_line("    std::uint8_t _mask[", maskSize, "] = {};");
+	sourceBuffer.push_line("    const std::size_t _end = stream.beginBlock();");
+	sourceBuffer.push_line("    stream.readArray(_mask, ", maskSize, ");");
+	// the baseline is read by the nested objects and copied into the unchanged properties, except the move-only ones
+	const bool readsBaseline = std::any_of(fields.begin(), fields.end(), [&symbolTable, &collection](const Property& field)
+		{
+			const PropertyType propertyType = parsePropertyType(symbolTable, field.type);
+			return propertyType == PropertyType::T_type || propertyType == PropertyType::T_native
+				|| isDeltaCopyable(symbolTable, collection, field.type);
+		});
+	if (!readsBaseline)
+	{
+		sourceBuffer.push_line("    static_cast<void>(baseline);");
+	}
+	if (fields.empty())
+	{
+		sourceBuffer.push_line("    static_cast<void>(type);");
+	}
+	for (std::size_t index = 0; index < fields.size(); ++index)
+	{
+		sourceBuffer.push_line(encodeDeltaField("    ", symbolTable, collection, false, fields[index], index));
+	}
+	sourceBuffer.push_line("    stream.endBlock(_end);");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("reflect::encoding::ByteBuffer reflect::Type<", type.name, ">::to_flat(const ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    reflect::encoding::ByteBuffer buffer;");
+	sourceBuffer.push_line("    reflect::encoding::FlatBuilder builder(buffer);");
+	sourceBuffer.push_line("    builder.finish(write_flat(builder, type));");
+	sourceBuffer.push_line("    return buffer;");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("std::size_t reflect::Type<", type.name, ">::write_flat(reflect::encoding::FlatBuilder& builder, const ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    const std::size_t table = builder.beginTable(", fields.size(), ");");
+	bool hasFlatField = false;
+	for (std::size_t slot = 0; slot < fields.size(); ++slot)
+	{
+		const std::string temp = encodeFlatField("    ", symbolTable, fields[slot], slot);
+		if (!temp.empty())
+		{
+			sourceBuffer.push_line(temp);
+			hasFlatField = true;
+		}
+	}
+	if (!hasFlatField)
+	{
+		sourceBuffer.push_line("    static_cast<void>(type); // no property has a flat representation");
+	}
+	sourceBuffer.push_line("    return table;");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	for (std::size_t slot = 0; slot < fields.size(); ++slot)
+	{
+		const Property& field = fields[slot];
+		const std::string accessor = encodeFlatAccessorType(symbolTable, field.type);
+		if (accessor.empty()) continue;
+
+		sourceBuffer.push_line(accessor, " reflect::Type<", type.name, ">::Flat::", field.name, "() const");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line(encodeFlatAccessor("    ", symbolTable, field.type, slot));
+		sourceBuffer.push_line("}");
+	}
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::from_json(const std::string& json, ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    reflect::encoding::json::Reader reader(json);");
+	sourceBuffer.push_line("    read_json(reader, type);");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::read_json(reflect::encoding::json::Reader& reader, ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	if (isTracked)
+	{
+		sourceBuffer.push_line("    type.invalidate_cache();");
+	}
+	sourceBuffer.push_line("    if (!reader.beginObject())");
+	sourceBuffer.push_line("    {");
+	sourceBuffer.push_line("        reader.skipValue();");
+	sourceBuffer.push_line("        return;");
+	sourceBuffer.push_line("    }");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("    std::string_view key;");
+	sourceBuffer.push_line("    while (reader.nextKey(key))");
+	sourceBuffer.push_line("    {");
+	// the keys are dispatched on their length and first character, then compared once
+	std::map<std::size_t, std::map<char, std::vector<std::string>>> keys;
+	const auto& addKey = [&keys, &symbolTable](const Property& property)
+		{
+			const bool serialize = false;
+			std::string temp = encodePropertySerializationToJson("                ", symbolTable, serialize, property);
+			if (!temp.empty() && !property.name.empty())
+				keys[property.name.size()][property.name.front()].push_back(temp);
+		};
+	// look for parent classes
+	parent_name = type.parent;
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
+	{
+		TypeClass* const parentClass = collection.findClass(parent_name);
+		if (parentClass == nullptr)
+		{
+			std::cout << "Cannot find the parent class " << parent_name << std::endl;
+			return false;
+		}
+
+		for (const Property& property : parentClass->properties)
+		{
+			addKey(property);
+		}
+
+		parent_name = parentClass->parent;
+	}
+	for (const Property& property : type.properties)
+	{
+		addKey(property);
+	}
+	if (!keys.empty())
+	{
+		sourceBuffer.push_line("        switch (key.size())");
+		sourceBuffer.push_line("        {");
+		for (const auto& [size, characters] : keys)
+		{
+			sourceBuffer.push_line("        case ", size, ":");
+			sourceBuffer.push_line("            switch (key[0])");
+			sourceBuffer.push_line("            {");
+			for (const auto& [character, properties] : characters)
+			{
+				sourceBuffer.push_line("            case '", character, "':");
+				for (const std::string& property : properties)
+				{
+					sourceBuffer.push_line(property);
+				}
+				sourceBuffer.push_line("                break;");
+			}
+			sourceBuffer.push_line("            }");
+			sourceBuffer.push_line("            break;");
+		}
+		sourceBuffer.push_line("        }");
+	}
+	sourceBuffer.push_line("        reader.skipValue();");
+	sourceBuffer.push_line("    }");
 	sourceBuffer.push_line("}");
 	sourceBuffer.push_line("");
 	sourceBuffer.push_line("std::string reflect::Type<", type.name, ">::to_json(const ", type.name, "& type, const std::string& offset)");
 	sourceBuffer.push_line("{");
-	sourceBuffer.push_line("    std::stringstream stream;");
-	sourceBuffer.push_line("    stream << \"{\" << std::endl;");
-	sourceBuffer.push_line("    stream << offset << \"    \" << \"\\\"type_id\\\": \" << \"\\\"", type.name, "\\\"\" << \",\" << std::endl;");
+	sourceBuffer.push_line("    std::string json;");
+	sourceBuffer.push_line("    reflect::encoding::json::Writer writer(json, false, offset);");
+	sourceBuffer.push_line("    to_json(writer, type);");
+	sourceBuffer.push_line("    return json;");
+	sourceBuffer.push_line("}");
+	sourceBuffer.push_line("");
+	sourceBuffer.push_line("void reflect::Type<", type.name, ">::to_json(reflect::encoding::json::Writer& writer, const ", type.name, "& type)");
+	sourceBuffer.push_line("{");
+	sourceBuffer.push_line("    writer.beginObject();");
+	sourceBuffer.push_line("    writer.key(\"type_id\"); writer.value(\"", type.name, "\");");
 	// look for parent classes
 	has_parent = false;
 	parent_name = type.parent;
-	while (parent_name != "IType" && !isNativeClass)
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
 	{
 		has_parent = true;
 		TypeClass* const parentClass = collection.findClass(parent_name);
@@ -494,12 +811,70 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 		if (!temp.empty())
 			sourceBuffer.push_line(temp);
 	}
-	sourceBuffer.push_line("    stream << offset << \"}\";");
-	sourceBuffer.push_line("    return stream.str();");
+	sourceBuffer.push_line("    writer.endObject();");
 	sourceBuffer.push_line("}");
 	sourceBuffer.push_line("");
-	if (!isNativeClass)
+	if (isTracked)
+	{
+		for (const Property& field : fields)
+		{
+			sourceBuffer.push_line("void reflect::Type<", type.name, ">::set_", field.name, "(", type.name, "& type, ", field.type, " value)");
+			sourceBuffer.push_line("{");
+			sourceBuffer.push_line("    type.", field.name, " = std::move(value);");
+			sourceBuffer.push_line("    type.mark_dirty(Dirty::", field.name, ");");
+			sourceBuffer.push_line("}");
+			sourceBuffer.push_line("");
+		}
+
+		// the writes go through the cached forms, the static decoding functions invalidate them
+		sourceBuffer.push_line("reflect::type_id_t ", type.name, "::type_id() const { return reflect::Type<", type.name, ">::id(); }");
+		sourceBuffer.push_line("const reflect::meta_t& ", type.name, "::type_meta() const { return reflect::Type<", type.name, ">::meta(); }");
+		sourceBuffer.push_line("const char* const ", type.name, "::type_name() const { return reflect::Type<", type.name, ">::name(); }");
+		sourceBuffer.push_line("const reflect::properties_t& ", type.name, "::type_properties() const { return reflect::Type<", type.name, ">::properties(); }");
+		sourceBuffer.push_line(type.name, "::operator std::string() const { return to_string(reflect::encoding::ByteFormat{}); }");
+		sourceBuffer.push_line("void ", type.name, "::from_string(const std::string& str)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::from_string(str, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_bytes(reflect::encoding::InputByteStream& stream)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read(stream, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_bytes_body(reflect::encoding::InputByteStream& stream)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read_body(stream, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::to_bytes(reflect::encoding::OutputByteStream& stream) const");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    write_cached(stream, [this](reflect::encoding::OutputByteStream& cache) { reflect::Type<", type.name, ">::write(cache, *this); });");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("std::size_t ", type.name, "::binary_size(const reflect::encoding::ByteFormat& format) const");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    return binary_size_cached(format, [this, &format]() { return reflect::Type<", type.name, ">::binary_size(*this, format); });");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_json(const std::string& json)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::from_json(json, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_json(reflect::encoding::json::Reader& reader)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read_json(reader, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("std::string ", type.name, "::to_json(const std::string& offset) const");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    return to_json_cached(offset, [this, &offset]() { return reflect::Type<", type.name, ">::to_json(*this, offset); });");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<", type.name, ">::to_json(writer, *this); }");
+		sourceBuffer.push_line("");
+	}
+	else if (!isNativeClass)
 	{
+		sourceBuffer.push_line("reflect::type_id_t ", type.name, "::type_id() const { return reflect::Type<", type.name, ">::id(); }");
 		sourceBuffer.push_line("const reflect::meta_t& ", type.name, "::type_meta() const { return reflect::Type<", type.name, ">::meta(); }");
 		sourceBuffer.push_line("const char* const ", type.name, "::type_name() const { return reflect::Type<", type.name, ">::name(); }");
 		sourceBuffer.push_line("const reflect::properties_t& ", type.name, "::type_properties() const { return reflect::Type<", type.name, ">::properties(); }");
@@ -509,12 +884,30 @@ bool Encoder::encode(EncodeBuffer& headerBuffer, EncodeBuffer& sourceBuffer, con
 		sourceBuffer.push_line("    reflect::Type<", type.name, ">::from_string(str, *this);");
 		sourceBuffer.push_line("    type_initialize();");
 		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_bytes(reflect::encoding::InputByteStream& stream)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read(stream, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_bytes_body(reflect::encoding::InputByteStream& stream)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read_body(stream, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::to_bytes(reflect::encoding::OutputByteStream& stream) const { reflect::Type<", type.name, ">::write(stream, *this); }");
+		sourceBuffer.push_line("std::size_t ", type.name, "::binary_size(const reflect::encoding::ByteFormat& format) const { return reflect::Type<", type.name, ">::binary_size(*this, format); }");
 		sourceBuffer.push_line("void ", type.name, "::from_json(const std::string& json)");
 		sourceBuffer.push_line("{");
 		sourceBuffer.push_line("    reflect::Type<", type.name, ">::from_json(json, *this);");
 		sourceBuffer.push_line("    type_initialize();");
 		sourceBuffer.push_line("}");
+		sourceBuffer.push_line("void ", type.name, "::from_json(reflect::encoding::json::Reader& reader)");
+		sourceBuffer.push_line("{");
+		sourceBuffer.push_line("    reflect::Type<", type.name, ">::read_json(reader, *this);");
+		sourceBuffer.push_line("    type_initialize();");
+		sourceBuffer.push_line("}");
 		sourceBuffer.push_line("std::string ", type.name, "::to_json(const std::string& offset) const { return reflect::Type<", type.name, ">::to_json(*this, offset); }");
+		sourceBuffer.push_line("void ", type.name, "::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<", type.name, ">::to_json(writer, *this); }");
 		sourceBuffer.push_line("");
 	}
 
@@ -590,6 +983,83 @@ std::string Encoder::encodePropertyReflection(const std::string& offset, const S
 	return ("reflect::PropertyType{ \"" + type + "\", { " + buffer.string(false) + "}, " + toString(decoratorType) + ", sizeof(" + type + "), " + toString(PropertyType) + " }");
 }
 
+bool Encoder::collectFields(const SymbolTable& symbolTable, const TypeCollection& collection, const TypeClass& type, const bool isNativeClass, std::vector<Property>& fields)
+{
+	std::vector<const TypeClass*> classes;
+	std::string parent_name = type.parent;
+	while (!TypeClass::isRootClass(parent_name) && !isNativeClass)
+	{
+		TypeClass* const parentClass = collection.findClass(parent_name);
+		if (parentClass == nullptr)
+		{
+			std::cout << "Cannot find the parent class " << parent_name << std::endl;
+			return false;
+		}
+		classes.push_back(parentClass);
+		parent_name = parentClass->parent;
+	}
+	classes.push_back(&type);
+
+	std::map<unsigned int, std::string> tags;
+	for (const TypeClass* const eClass : classes)
+	{
+		for (const Property& property : eClass->properties)
+		{
+			if (encodePropertySerialization("", symbolTable, true, property).empty()) continue;
+
+			const auto& it = tags.insert(std::make_pair(fieldTag(property), property.name));
+			if (!it.second)
+			{
+				std::cout << "The properties " << it.first->second << " and " << property.name << " of " << type.name << " have the same field tag" << std::endl;
+				return false;
+			}
+			fields.push_back(property);
+		}
+	}
+	return true;
+}
+
+unsigned int Encoder::fieldTag(const Property& property)
+{
+	const unsigned long long hash = StringUtil::hash(property.name);
+	return static_cast<unsigned int>(hash ^ (hash >> 32));
+}
+
+std::string Encoder::encodeField(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const Property& property)
+{
+	const std::string temp = encodePropertySerialization(offset + "    ", symbolTable, serialize, property);
+	if (temp.empty()) return "";
+
+	EncodeBuffer buffer;
+	buffer.push(offset, "{");
+	if (serialize)
+	{
+		buffer.push("\n", offset, "    ", "const std::size_t field = stream.beginField(0x", std::hex, fieldTag(property), std::dec, "u);");
+	}
+	else
+	{
+		buffer.push("\n", offset, "    ", "const std::size_t field = stream.beginField();");
+	}
+	buffer.push("\n", temp);
+	buffer.push("\n", offset, "    ", "stream.endField(field);");
+	buffer.push("\n", offset, "}");
+	return buffer.string(false);
+}
+
+std::string Encoder::encodeFieldSize(const std::string& offset, const SymbolTable& symbolTable, const Property& property)
+{
+	const std::string temp = encodePropertySize(offset + "    ", symbolTable, property);
+	if (temp.empty()) return "";
+
+	EncodeBuffer buffer;
+	buffer.push(offset, "{");
+	buffer.push("\n", offset, "    ", "const std::size_t field = size;");
+	buffer.push("\n", temp);
+	buffer.push("\n", offset, "    ", "size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);");
+	buffer.push("\n", offset, "}");
+	return buffer.string(false);
+}
+
 std::string Encoder::encodePropertySerialization(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const Property& property)
 {
 	return encodePropertySerialization(offset, symbolTable, serialize, "type." + property.name, property.type);
@@ -635,14 +1105,14 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << reflect::Type<", type, ">::to_string(", name, ");");
+			buffer.push(offset, "stream.writeBlock(", name, ");");
 		}
 		else
 		{
 			buffer.push(offset, "{");
-			buffer.push("\n", offset, "    ", "std::string pack;");
-			buffer.push("\n", offset, "    ", "stream >> pack;");
-			buffer.push("\n", offset, "    reflect::Type<", type, ">::from_string(pack, ", name, ");");
+			buffer.push("\n", offset, "    ", "const std::size_t end = stream.beginBlock();");
+			buffer.push("\n", offset, "    reflect::Type<", type, ">::read(stream, ", name, ");");
+			buffer.push("\n", offset, "    ", "stream.endBlock(end);");
 			buffer.push("\n", offset, "}");
 		}
 		break;
@@ -659,16 +1129,64 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 		{
 			if (!isValidListType(symbolTable, parsePropertyType(symbolTable, typenames[0]), typenames[0])) break;
 
-			buffer.push(offset, "{");
-			if (serialize)
+			if (isTriviallyCopyableVector(symbolTable, type, typenames[0]))
 			{
-				buffer.push("\n", offset, "    ", "stream << ", name, ".size();");
-				buffer.push("\n", offset, "    ", "for (const auto& element : ", name, ")");
+				buffer.push(offset, "{");
+				if (serialize)
+				{
+					buffer.push("\n", offset, "    ", "stream << ", name, ".size();");
+					buffer.push("\n", offset, "    ", "stream.writeArray(", name, ".data(), ", name, ".size());");
+				}
+				else
+				{
+					buffer.push("\n", offset, "    ", "std::size_t size{ 0 };");
+					buffer.push("\n", offset, "    ", "stream >> size;");
+					buffer.push("\n", offset, "    ", name, ".resize(stream.clampArray<", typenames[0], ">(size));");
+					buffer.push("\n", offset, "    ", "stream.readArray(", name, ".data(), ", name, ".size());");
+				}
+				buffer.push("\n", offset, "}");
+				break;
 			}
-			else
+
+			if (!serialize && isPointerVector(symbolTable, type, typenames[0]))
 			{
+				// every element is a self-contained block, large vectors can be decoded concurrently
+				buffer.push(offset, "{");
 				buffer.push("\n", offset, "    ", name, ".clear();");
-				buffer.push("\n", offset, "    ", "std::size_t size;");
+				buffer.push("\n", offset, "    ", "std::size_t size{ 0 };");
+				buffer.push("\n", offset, "    ", "stream >> size;");
+				buffer.push("\n", offset, "    ", "if (stream.isParallel(size))");
+				buffer.push("\n", offset, "    ", "{");
+				buffer.push("\n", offset, "        ", name, ".resize(stream.clampArray<bool>(size));");
+				buffer.push("\n", offset, "        ", "stream.readParallel(", name, ".size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)");
+				buffer.push("\n", offset, "        ", "{");
+				buffer.push("\n", offset, "            ", "auto& element = ", name, "[i];");
+				buffer.push("\n", encodePropertySerialization(offset + "            ", symbolTable, serialize, "element", typenames[0]));
+				buffer.push("\n", offset, "        ", "});");
+				buffer.push("\n", offset, "    ", "}");
+				buffer.push("\n", offset, "    ", "else");
+				buffer.push("\n", offset, "    ", "{");
+				buffer.push("\n", offset, "        ", "for (int i = 0; i < size; ++i)");
+				buffer.push("\n", offset, "        ", "{");
+				buffer.push("\n", offset, "            ", typenames[0], " element;");
+				buffer.push("\n", encodePropertySerialization(offset + "            ", symbolTable, serialize, "element", typenames[0]));
+				buffer.push("\n", offset, "            ", name, ".push_back(std::move(element));");
+				buffer.push("\n", offset, "        ", "}");
+				buffer.push("\n", offset, "    ", "}");
+				buffer.push("\n", offset, "}");
+				break;
+			}
+
+			buffer.push(offset, "{");
+			if (serialize)
+			{
+				buffer.push("\n", offset, "    ", "stream << ", name, ".size();");
+				buffer.push("\n", offset, "    ", "for (const auto& element : ", name, ")");
+			}
+			else
+			{
+				buffer.push("\n", offset, "    ", name, ".clear();");
+				buffer.push("\n", offset, "    ", "std::size_t size{ 0 };");
 				buffer.push("\n", offset, "    ", "stream >> size;");
 				buffer.push("\n", offset, "    ", "for (int i = 0; i < size; ++i)");
 			}
@@ -709,7 +1227,8 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 			}
 			else
 			{
-				buffer.push("\n", offset, "    ", "std::size_t size;");
+				buffer.push("\n", offset, "    ", name, ".clear();");
+				buffer.push("\n", offset, "    ", "std::size_t size{ 0 };");
 				buffer.push("\n", offset, "    ", "stream >> size;");
 				buffer.push("\n", offset, "    ", "for (int i = 0; i < size; ++i)");
 				buffer.push("\n", offset, "    ", "{");
@@ -730,35 +1249,27 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 
 			if (serialize)
 			{
-				buffer.push(offset, "stream << (", name, " ? true : false); ");
-				buffer.push("\n", offset, "if(", name, ") stream << static_cast<std::string>(*", name, ");");
+				buffer.push(offset, "stream.writeShared(", name, ");");
 			}
 			else
 			{
-				buffer.push(offset, "{");
-				buffer.push("\n", offset, "    ", "bool valid = false;");
-				buffer.push("\n", offset, "    ", "stream >> valid;");
-				buffer.push("\n", offset, "    ", "if (valid)");
+				// null and already decoded objects are resolved by readShared
+				buffer.push(offset, "if (stream.readShared(", name, "))");
+				buffer.push("\n", offset, "{");
+				buffer.push("\n", offset, "    ", "const std::size_t end = stream.beginBlock();");
+				buffer.push("\n", offset, "    ", "reflect::type_id_t type_id{ 0 };");
+				buffer.push("\n", offset, "    ", "stream.readFixed(type_id);");
+				buffer.push("\n", offset, "    ", "if (type_id == Type<", extractTypenames(type)[0], ">::id())");
 				buffer.push("\n", offset, "    ", "{");
-				buffer.push("\n", offset, "        ", "reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());");
-				buffer.push("\n", offset, "        ", "std::size_t temp_element_size;");
-				buffer.push("\n", offset, "        ", "temp_stream >> temp_element_size;");
-				buffer.push("\n", offset, "        ", "std::string type_id;");
-				buffer.push("\n", offset, "        ", "temp_stream >> type_id;");
-				buffer.push("\n", offset, "        ", "if (type_id == Type<", extractTypenames(type)[0], ">::name())");
-				buffer.push("\n", offset, "        ", "{");
-				buffer.push("\n", offset, "        ", "    ", name, " = std::make_shared<", extractTypenames(type)[0], ">();");
-				buffer.push("\n", offset, "        ", "}");
-				buffer.push("\n", offset, "        ", "else");
-				buffer.push("\n", offset, "        ", "{");
-				buffer.push("\n", offset, "        ", "    ", name, " = std::shared_ptr<", extractTypenames(type)[0], ">(TypeFactory::instantiate<", extractTypenames(type)[0], ">(type_id));");
-				buffer.push("\n", offset, "        ", "}");
-				buffer.push("\n", offset, "        ", "{");
-				buffer.push("\n", offset, "        ", "    ", "std::string pack;");
-				buffer.push("\n", offset, "        ", "    ", "stream >> pack;");
-				buffer.push("\n", offset, "        ", "    ", name, "->from_string(pack);");
-				buffer.push("\n", offset, "        ", "}");
+				buffer.push("\n", offset, "    ", "    ", name, " = stream.makeShared<", extractTypenames(type)[0], ">();");
+				buffer.push("\n", offset, "    ", "}");
+				buffer.push("\n", offset, "    ", "else");
+				buffer.push("\n", offset, "    ", "{");
+				buffer.push("\n", offset, "    ", "    ", name, " = TypeFactory::instantiate_shared<", extractTypenames(type)[0], ">(type_id, stream.getResource());");
 				buffer.push("\n", offset, "    ", "}");
+				buffer.push("\n", offset, "    ", "stream.addShared(", name, ");");
+				buffer.push("\n", offset, "    ", "if (", name, ") ", name, "->from_bytes_body(stream);");
+				buffer.push("\n", offset, "    ", "stream.endBlock(end);");
 				buffer.push("\n", offset, "}");
 			}
 		}
@@ -769,7 +1280,7 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 			if (serialize)
 			{
 				buffer.push(offset, "stream << (", name, " ? true : false); ");
-				buffer.push("\n", offset, "if(", name, ") stream << static_cast<std::string>(*", name, ");");
+				buffer.push("\n", offset, "if (", name, ") stream.writeBlock(*", name, ");");
 			}
 			else
 			{
@@ -778,12 +1289,10 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 				buffer.push("\n", offset, "    ", "stream >> valid;");
 				buffer.push("\n", offset, "    ", "if (valid)");
 				buffer.push("\n", offset, "    ", "{");
-				buffer.push("\n", offset, "        ", "reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());");
-				buffer.push("\n", offset, "        ", "std::size_t temp_element_size;");
-				buffer.push("\n", offset, "        ", "temp_stream >> temp_element_size;");
-				buffer.push("\n", offset, "        ", "std::string type_id;");
-				buffer.push("\n", offset, "        ", "temp_stream >> type_id;");
-				buffer.push("\n", offset, "        ", "if (type_id == Type<", extractTypenames(type)[0], ">::name())");
+				buffer.push("\n", offset, "        ", "const std::size_t end = stream.beginBlock();");
+				buffer.push("\n", offset, "        ", "reflect::type_id_t type_id{ 0 };");
+				buffer.push("\n", offset, "        ", "stream.readFixed(type_id);");
+				buffer.push("\n", offset, "        ", "if (type_id == Type<", extractTypenames(type)[0], ">::id())");
 				buffer.push("\n", offset, "        ", "{");
 				buffer.push("\n", offset, "        ", "    ", name, " = std::make_unique<", extractTypenames(type)[0], ">();");
 				buffer.push("\n", offset, "        ", "}");
@@ -791,11 +1300,8 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 				buffer.push("\n", offset, "        ", "{");
 				buffer.push("\n", offset, "        ", "    ", name, " = std::unique_ptr<", extractTypenames(type)[0], ">(TypeFactory::instantiate<", extractTypenames(type)[0], ">(type_id));");
 				buffer.push("\n", offset, "        ", "}");
-				buffer.push("\n", offset, "        ", "{");
-				buffer.push("\n", offset, "        ", "    ", "std::string pack;");
-				buffer.push("\n", offset, "        ", "    ", "stream >> pack;");
-				buffer.push("\n", offset, "        ", "    ", name, "->from_string(pack);");
-				buffer.push("\n", offset, "        ", "}");
+				buffer.push("\n", offset, "        ", "if (", name, ") ", name, "->from_bytes_body(stream);");
+				buffer.push("\n", offset, "        ", "stream.endBlock(end);");
 				buffer.push("\n", offset, "    ", "}");
 				buffer.push("\n", offset, "}");
 			}
@@ -806,16 +1312,123 @@ std::string Encoder::encodePropertySerialization(const std::string& offset, cons
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << static_cast<std::string>(", name, ");");
+			buffer.push(offset, "stream.writeBlock(", name, ");");
 		}
 		else
 		{
 			buffer.push(offset, "{");
-			buffer.push("\n", offset, "    ", "std::string pack;");
-			buffer.push("\n", offset, "    ", "stream >> pack;");
-			buffer.push("\n", offset, "    ", name, ".from_string(pack);");
+			buffer.push("\n", offset, "    ", "const std::size_t end = stream.beginBlock();");
+			buffer.push("\n", offset, "    ", name, ".from_bytes(stream);");
+			buffer.push("\n", offset, "    ", "stream.endBlock(end);");
+			buffer.push("\n", offset, "}");
+		}
+		break;
+	}
+	default:
+	case PropertyType::T_void:
+	case PropertyType::T_unknown:
+		break;
+	}
+
+	return buffer.string(false);
+}
+
+std::string Encoder::encodePropertySize(const std::string& offset, const SymbolTable& symbolTable, const Property& property)
+{
+	return encodePropertySize(offset, symbolTable, "type." + property.name, property.type);
+}
+
+std::string Encoder::encodePropertySize(const std::string& offset, const SymbolTable& symbolTable, const std::string& name, const std::string& type)
+{
+	const DecoratorType decoratorType = parseDecoratorType(symbolTable, type);
+	const PropertyType PropertyType = parsePropertyType(symbolTable, type);
+	EncodeBuffer buffer;
+
+	if (decoratorType != DecoratorType::D_raw) return "";
+
+	switch (PropertyType)
+	{
+	case PropertyType::T_bool:
+	case PropertyType::T_char:
+	case PropertyType::T_double:
+	case PropertyType::T_float:
+	case PropertyType::T_int:
+	case PropertyType::T_string:
+	{
+		buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOf(", name, ", format);");
+		break;
+	}
+	case PropertyType::T_enum:
+	{
+		buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOf(static_cast<int>(", name, "), format);");
+		break;
+	}
+	case PropertyType::T_native:
+	{
+		buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOfBlock(reflect::Type<", type, ">::binary_size(", name, ", format), format);");
+		break;
+	}
+	case PropertyType::T_template:
+	{
+		std::vector<std::string> typenames;
+		typenames = extractTypenames(type);
+
+		if (typenames.empty()) break;
+
+		if (StringUtil::startsWith(type, "vector") || StringUtil::startsWith(type, "std::vector")
+			|| StringUtil::startsWith(type, "list") || StringUtil::startsWith(type, "std::list"))
+		{
+			if (!isValidListType(symbolTable, parsePropertyType(symbolTable, typenames[0]), typenames[0])) break;
+
+			if (isTriviallyCopyableVector(symbolTable, type, typenames[0]))
+			{
+				buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOf(", name, ".size(), format);");
+				buffer.push("\n", offset, "size += reflect::encoding::OutputByteStream::sizeOfArray(", name, ".data(), ", name, ".size(), format);");
+				break;
+			}
+
+			buffer.push(offset, "{");
+			buffer.push("\n", offset, "    ", "size += reflect::encoding::OutputByteStream::sizeOf(", name, ".size(), format);");
+			buffer.push("\n", offset, "    ", "for (const auto& element : ", name, ")");
+			buffer.push("\n", offset, "    ", "{");
+			buffer.push("\n", encodePropertySize(offset + "        ", symbolTable, "element", typenames[0]));
+			buffer.push("\n", offset, "    ", "}");
+			buffer.push("\n", offset, "}");
+		}
+		else if (StringUtil::startsWith(type, "map") || StringUtil::startsWith(type, "std::map")
+			|| StringUtil::startsWith(type, "unordered_map") || StringUtil::startsWith(type, "std::unordered_map"))
+		{
+			if (typenames.size() < 2) break;
+			if (!isValidMapKeyType(parsePropertyType(symbolTable, typenames[0]))
+				|| !isValidMapValueType(symbolTable, parsePropertyType(symbolTable, typenames[1]), typenames[1])) break;
+
+			buffer.push(offset, "{");
+			buffer.push("\n", offset, "    ", "size += reflect::encoding::OutputByteStream::sizeOf(", name, ".size(), format);");
+			buffer.push("\n", offset, "    ", "for (const auto& pair : ", name, ")");
+			buffer.push("\n", offset, "    ", "{");
+			buffer.push("\n", encodePropertySize(offset + "        ", symbolTable, "pair.first", typenames[0]));
+			buffer.push("\n", encodePropertySize(offset + "        ", symbolTable, "pair.second", typenames[1]));
+			buffer.push("\n", offset, "    ", "}");
 			buffer.push("\n", offset, "}");
 		}
+		else if (StringUtil::startsWith(type, "shared_ptr") || StringUtil::startsWith(type, "std::shared_ptr"))
+		{
+			if (parsePropertyType(symbolTable, typenames[0]) != PropertyType::T_type) break;
+
+			buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOfShared(", name, ", format);");
+		}
+		else if (StringUtil::startsWith(type, "unique_ptr") || StringUtil::startsWith(type, "std::unique_ptr"))
+		{
+			if (parsePropertyType(symbolTable, typenames[0]) != PropertyType::T_type) break;
+
+			buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOf(", name, " ? true : false, format);");
+			buffer.push("\n", offset, "if (", name, ") size += reflect::encoding::OutputByteStream::sizeOfBlock(", name, "->binary_size(format), format);");
+		}
+		break;
+	}
+	case PropertyType::T_type:
+	{
+		buffer.push(offset, "size += reflect::encoding::OutputByteStream::sizeOfBlock(", name, ".binary_size(format), format);");
 		break;
 	}
 	default:
@@ -851,11 +1464,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(type.", name, ") << \",\" << std::endl;");
+			buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, type.", name, ");");
 		}
 		else
 		{
-			buffer.push(offset, "if (key == \"", name, "\") reflect::encoding::json::Deserializer::parse(value, type.", name, ");");
+			buffer.push(offset, "if (key == \"", name, "\") { reflect::encoding::json::Deserializer::read(reader, type.", name, "); continue; }");
 		}
 		break;
 	}
@@ -863,15 +1476,16 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(enumToString(type.", name, ")) << \",\" << std::endl;");
+			buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, enumToString(type.", name, "));");
 		}
 		else
 		{
 			buffer.push(offset, "if (key == \"", name, "\")");
 			buffer.push("\n", offset, "{");
 			buffer.push("\n", offset, "    std::string temp;");
-			buffer.push("\n", offset, "    reflect::encoding::json::Deserializer::parse(value, temp);");
+			buffer.push("\n", offset, "    reflect::encoding::json::Deserializer::read(reader, temp);");
 			buffer.push("\n", offset, "    stringToEnum(temp, type.", name, ");");
+			buffer.push("\n", offset, "    continue;");
 			buffer.push("\n", offset, "}");
 		}
 		break;
@@ -880,11 +1494,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::Type<", type, ">::to_json(type.", name, ", offset + \"    \") << \",\" << std::endl;");
+			buffer.push(offset, "writer.key(\"", name, "\"); reflect::Type<", type, ">::to_json(writer, type.", name, ");");
 		}
 		else
 		{
-			buffer.push(offset, "if (key == \"", name, "\") reflect::Type<", type, ">::from_json(value, type.", name, ");");
+			buffer.push(offset, "if (key == \"", name, "\") { reflect::Type<", type, ">::read_json(reader, type.", name, "); continue; }");
 		}
 		break;
 	}
@@ -902,11 +1516,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 
 			if (serialize)
 			{
-				buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(type.", name, ") << \",\" << std::endl;");
+				buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, type.", name, ");");
 			}
 			else
 			{
-				buffer.push(offset, "if (key == \"", name, "\") reflect::encoding::json::Deserializer::parse(value, type.", name, ");");
+				buffer.push(offset, "if (key == \"", name, "\") { reflect::encoding::json::Deserializer::read(reader, type.", name, "); continue; }");
 			}
 		}
 		else if (StringUtil::startsWith(type, "map") || StringUtil::startsWith(type, "std::map")
@@ -918,11 +1532,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 
 			if (serialize)
 			{
-				buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(type.", name, ") << \",\" << std::endl;");
+				buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, type.", name, ");");
 			}
 			else
 			{
-				buffer.push(offset, "if (key == \"", name, "\") reflect::encoding::json::Deserializer::parse(value, type.", name, ");");
+				buffer.push(offset, "if (key == \"", name, "\") { reflect::encoding::json::Deserializer::read(reader, type.", name, "); continue; }");
 			}
 		}
 		else if (StringUtil::startsWith(type, "shared_ptr") || StringUtil::startsWith(type, "std::shared_ptr"))
@@ -931,11 +1545,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 
 			if (serialize)
 			{
-				buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(type.", name, ") << \",\" << std::endl;");
+				buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, type.", name, ");");
 			}
 			else
 			{
-				buffer.push(offset, "if (key == \"", name, "\") reflect::encoding::json::Deserializer::parse(value, type.", name, ");");
+				buffer.push(offset, "if (key == \"", name, "\") { reflect::encoding::json::Deserializer::read(reader, type.", name, "); continue; }");
 			}
 		}
 		else if (StringUtil::startsWith(type, "unique_ptr") || StringUtil::startsWith(type, "std::unique_ptr"))
@@ -944,11 +1558,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 
 			if (serialize)
 			{
-				buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << reflect::encoding::json::Serializer::to_string(type.", name, ") << \",\" << std::endl;");
+				buffer.push(offset, "writer.key(\"", name, "\"); reflect::encoding::json::Serializer::write(writer, type.", name, ");");
 			}
 			else
 			{
-				buffer.push(offset, "if (key == \"", name, "\") reflect::encoding::json::Deserializer::parse(value, type.", name, ");");
+				buffer.push(offset, "if (key == \"", name, "\") { reflect::encoding::json::Deserializer::read(reader, type.", name, "); continue; }");
 			}
 		}
 		break;
@@ -957,11 +1571,11 @@ std::string Encoder::encodePropertySerializationToJson(const std::string& offset
 	{
 		if (serialize)
 		{
-			buffer.push(offset, "stream << offset << \"    \" << \"\\\"", name, "\\\": \" << type.", name, ".to_json(offset + \"    \") << \",\" << std::endl;");
+			buffer.push(offset, "writer.key(\"", name, "\"); type.", name, ".to_json(writer);");
 		}
 		else
 		{
-			buffer.push(offset, "if (key == \"", name, "\") type.", name, ".from_json(value);");
+			buffer.push(offset, "if (key == \"", name, "\") { type.", name, ".from_json(reader); continue; }");
 		}
 		break;
 	}
@@ -1097,6 +1711,292 @@ bool Encoder::isValidListType(const SymbolTable& symbolTable, const PropertyType
 	return true;
 }
 
+bool Encoder::isTriviallyCopyableVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token)
+{
+	if (!StringUtil::startsWith(type, "vector") && !StringUtil::startsWith(type, "std::vector")) return false;
+
+	// std::vector<bool> is not contiguous, enums are serialized as int
+	switch (parsePropertyType(symbolTable, token))
+	{
+	case PropertyType::T_char:
+	case PropertyType::T_double:
+	case PropertyType::T_float:
+	case PropertyType::T_int:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::string Encoder::encodeFlatField(const std::string& offset, const SymbolTable& symbolTable, const Property& property, const std::size_t slot)
+{
+	const std::string name = "type." + property.name;
+	const std::string& type = property.type;
+
+	EncodeBuffer buffer;
+	switch (parsePropertyType(symbolTable, type))
+	{
+	case PropertyType::T_bool:
+	case PropertyType::T_char:
+	case PropertyType::T_double:
+	case PropertyType::T_float:
+	case PropertyType::T_int:
+		buffer.push(offset, "builder.addScalar(table, ", slot, ", ", name, ");");
+		break;
+	case PropertyType::T_enum:
+		buffer.push(offset, "builder.addScalar(table, ", slot, ", static_cast<int>(", name, "));");
+		break;
+	case PropertyType::T_string:
+		buffer.push(offset, "builder.addString(table, ", slot, ", ", name, ");");
+		break;
+	case PropertyType::T_native:
+	case PropertyType::T_type:
+		buffer.push(offset, "builder.setSlot(table, ", slot, ", reflect::Type<", type, ">::write_flat(builder, ", name, "));");
+		break;
+	case PropertyType::T_template:
+	{
+		const std::vector<std::string> typenames = extractTypenames(type);
+		if (typenames.empty()) break;
+
+		if (isTriviallyCopyableVector(symbolTable, type, typenames[0]))
+		{
+			buffer.push(offset, "builder.addArray(table, ", slot, ", ", name, ".data(), ", name, ".size());");
+		}
+		else if (isTableVector(symbolTable, type, typenames[0]))
+		{
+			buffer.push(offset, "{");
+			buffer.push("\n", offset, "    ", "const std::size_t array = builder.beginTableArray(table, ", slot, ", ", name, ".size());");
+			buffer.push("\n", offset, "    ", "for (std::size_t i = 0; i < ", name, ".size(); ++i)");
+			buffer.push("\n", offset, "    ", "{");
+			buffer.push("\n", offset, "        ", "builder.setElement(array, i, reflect::Type<", typenames[0], ">::write_flat(builder, ", name, "[i]));");
+			buffer.push("\n", offset, "    ", "}");
+			buffer.push("\n", offset, "}");
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return buffer.string(false);
+}
+
+std::string Encoder::encodeFlatAccessorType(const SymbolTable& symbolTable, const std::string& type)
+{
+	switch (parsePropertyType(symbolTable, type))
+	{
+	case PropertyType::T_bool:
+	case PropertyType::T_char:
+	case PropertyType::T_double:
+	case PropertyType::T_float:
+	case PropertyType::T_int:
+	case PropertyType::T_enum:
+		return type;
+	case PropertyType::T_string:
+		return "std::string_view";
+	case PropertyType::T_native:
+	case PropertyType::T_type:
+		return "reflect::encoding::FlatTable";
+	case PropertyType::T_template:
+	{
+		const std::vector<std::string> typenames = extractTypenames(type);
+		if (typenames.empty()) return "";
+
+		if (isTriviallyCopyableVector(symbolTable, type, typenames[0]))
+		{
+			return "reflect::encoding::FlatArray<" + typenames[0] + ">";
+		}
+		if (isTableVector(symbolTable, type, typenames[0]))
+		{
+			return "reflect::encoding::FlatArray<reflect::encoding::FlatTable>";
+		}
+		return "";
+	}
+	default:
+		return "";
+	}
+}
+
+std::string Encoder::encodeFlatAccessor(const std::string& offset, const SymbolTable& symbolTable, const std::string& type, const std::size_t slot)
+{
+	EncodeBuffer buffer;
+	switch (parsePropertyType(symbolTable, type))
+	{
+	case PropertyType::T_enum:
+		buffer.push(offset, "return static_cast<", type, ">(m_table.scalar<int>(", slot, "));");
+		break;
+	case PropertyType::T_string:
+		buffer.push(offset, "return m_table.string(", slot, ");");
+		break;
+	case PropertyType::T_native:
+	case PropertyType::T_type:
+		buffer.push(offset, "return m_table.table(", slot, ");");
+		break;
+	case PropertyType::T_template:
+	{
+		const std::vector<std::string> typenames = extractTypenames(type);
+		const std::string element = isTableVector(symbolTable, type, typenames[0]) ? "reflect::encoding::FlatTable" : typenames[0];
+		buffer.push(offset, "return m_table.array<", element, ">(", slot, ");");
+		break;
+	}
+	default:
+		buffer.push(offset, "return m_table.scalar<", type, ">(", slot, ");");
+		break;
+	}
+	return buffer.string(false);
+}
+
+std::string Encoder::encodeDeltaField(const std::string& offset, const SymbolTable& symbolTable, const TypeCollection& collection, const bool serialize, const Property& property, const std::size_t index)
+{
+	const std::string name = "type." + property.name;
+	const std::string baseline = "baseline." + property.name;
+	const PropertyType propertyType = parsePropertyType(symbolTable, property.type);
+
+	std::stringstream bit;
+	bit << "_mask[" << index / 8 << "]";
+	const std::string mask = bit.str();
+	bit.str("");
+	bit << "0x" << std::hex << (1u << (index % 8));
+	const std::string flag = bit.str();
+
+	EncodeBuffer buffer;
+	if (propertyType == PropertyType::T_type || propertyType == PropertyType::T_native)
+	{
+		// nested objects send their own delta, dropped when nothing changed
+		if (serialize)
+		{
+			buffer.push(offset, "{");
+			buffer.push("\n", offset, "    ", "const std::size_t position = stream.getPosition();");
+			buffer.push("\n", offset, "    ", "if (reflect::Type<", property.type, ">::write_delta(", baseline, ", ", name, ", stream)) ", mask, " |= ", flag, ";");
+			buffer.push("\n", offset, "    ", "else stream.rewind(position);");
+			buffer.push("\n", offset, "}");
+		}
+		else
+		{
+			buffer.push(offset, "if (", mask, " & ", flag, ") reflect::Type<", property.type, ">::apply_delta(", baseline, ", stream, ", name, ");");
+			if (isDeltaCopyable(symbolTable, collection, property.type))
+			{
+				buffer.push("\n", offset, "else reflect::encoding::Delta::assign(", name, ", ", baseline, ");");
+			}
+		}
+		return buffer.string(false);
+	}
+
+	if (!serialize)
+	{
+		buffer.push(offset, "if (", mask, " & ", flag, ")");
+		buffer.push("\n", offset, "{");
+		buffer.push("\n", encodePropertySerialization(offset + "    ", symbolTable, serialize, name, property.type));
+		buffer.push("\n", offset, "}");
+		// unchanged properties come from the baseline, the move-only ones keep the value of the target
+		if (isDeltaCopyable(symbolTable, collection, property.type))
+		{
+			buffer.push("\n", offset, "else reflect::encoding::Delta::assign(", name, ", ", baseline, ");");
+		}
+		return buffer.string(false);
+	}
+
+	if (isDeltaComparable(symbolTable, property.type))
+	{
+		buffer.push(offset, "if (!(", baseline, " == ", name, "))");
+		buffer.push("\n", offset, "{");
+		buffer.push("\n", offset, "    ", mask, " |= ", flag, ";");
+		buffer.push("\n", encodePropertySerialization(offset + "    ", symbolTable, serialize, name, property.type));
+		buffer.push("\n", offset, "}");
+		return buffer.string(false);
+	}
+
+	// pointers and containers of objects are compared element by element, then encoded only if changed
+	buffer.push(offset, "if (reflect::encoding::Delta::changed(", baseline, ", ", name, ", stream))");
+	buffer.push("\n", offset, "{");
+	buffer.push("\n", offset, "    ", mask, " |= ", flag, ";");
+	buffer.push("\n", encodePropertySerialization(offset + "    ", symbolTable, serialize, name, property.type));
+	buffer.push("\n", offset, "}");
+	return buffer.string(false);
+}
+
+bool Encoder::isDeltaComparable(const SymbolTable& symbolTable, const std::string& type)
+{
+	switch (parsePropertyType(symbolTable, type))
+	{
+	case PropertyType::T_bool:
+	case PropertyType::T_char:
+	case PropertyType::T_double:
+	case PropertyType::T_enum:
+	case PropertyType::T_float:
+	case PropertyType::T_int:
+	case PropertyType::T_string:
+		return true;
+	case PropertyType::T_template:
+	{
+		if (StringUtil::startsWith(type, "unique_ptr") || StringUtil::startsWith(type, "std::unique_ptr")
+			|| StringUtil::startsWith(type, "shared_ptr") || StringUtil::startsWith(type, "std::shared_ptr")) return false;
+
+		const std::vector<std::string> typenames = extractTypenames(type);
+		for (const std::string& token : typenames)
+		{
+			if (!isDeltaComparable(symbolTable, token)) return false;
+		}
+		return !typenames.empty();
+	}
+	default:
+		return false;
+	}
+}
+
+bool Encoder::isDeltaCopyable(const SymbolTable& symbolTable, const TypeCollection& collection, const std::string& type)
+{
+	if (StringUtil::startsWith(type, "unique_ptr") || StringUtil::startsWith(type, "std::unique_ptr")) return false;
+	// the pointer is copied, not the object
+	if (StringUtil::startsWith(type, "shared_ptr") || StringUtil::startsWith(type, "std::shared_ptr")) return true;
+
+	switch (parsePropertyType(symbolTable, type))
+	{
+	case PropertyType::T_type:
+	case PropertyType::T_native:
+	{
+		const TypeClass* const typeClass = collection.findClass(type);
+		if (typeClass == nullptr) return false;
+
+		std::vector<Property> fields;
+		const bool isNativeClass = symbolTable.find(type)->second == SymbolType::S_nativeClass;
+		if (!collectFields(symbolTable, collection, *typeClass, isNativeClass, fields)) return false;
+		return std::all_of(fields.begin(), fields.end(), [&symbolTable, &collection](const Property& field)
+			{
+				return isDeltaCopyable(symbolTable, collection, field.type);
+			});
+	}
+	case PropertyType::T_template:
+	{
+		const std::vector<std::string> typenames = extractTypenames(type);
+		for (const std::string& token : typenames)
+		{
+			if (!isDeltaCopyable(symbolTable, collection, token)) return false;
+		}
+		return true;
+	}
+	default:
+		return true;
+	}
+}
+
+bool Encoder::isTableVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token)
+{
+	if (!StringUtil::startsWith(type, "vector") && !StringUtil::startsWith(type, "std::vector")) return false;
+
+	const PropertyType element = parsePropertyType(symbolTable, token);
+	return element == PropertyType::T_type || element == PropertyType::T_native;
+}
+
+bool Encoder::isPointerVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token)
+{
+	if (!StringUtil::startsWith(type, "vector") && !StringUtil::startsWith(type, "std::vector")) return false;
+	if (!StringUtil::startsWith(token, "unique_ptr") && !StringUtil::startsWith(token, "std::unique_ptr")
+		&& !StringUtil::startsWith(token, "shared_ptr") && !StringUtil::startsWith(token, "std::shared_ptr")) return false;
+
+	const std::vector<std::string> typenames = extractTypenames(token);
+	return !typenames.empty() && parsePropertyType(symbolTable, typenames[0]) == PropertyType::T_type;
+}
+
 bool Encoder::isValidMapKeyType(const PropertyType type)
 {
 	return type == PropertyType::T_enum
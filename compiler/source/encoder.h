@@ -60,9 +60,23 @@ private:
 	static std::string encodePropertyReflection(const std::string& offset, const SymbolTable& symbolTable, const Property& property, const std::string& name);
 	static std::string encodePropertyReflection(const std::string& offset, const SymbolTable& symbolTable, const std::string& type);
 
+	static bool collectFields(const SymbolTable& symbolTable, const TypeCollection& collection, const TypeClass& type, bool isNativeClass, std::vector<Property>& fields);
+	static unsigned int fieldTag(const Property& property);
+	static std::string encodeField(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const Property& property);
+	static std::string encodeFieldSize(const std::string& offset, const SymbolTable& symbolTable, const Property& property);
+
 	static std::string encodePropertySerialization(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const Property& property);
 	static std::string encodePropertySerialization(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const std::string& name, const std::string& type);
 
+	static std::string encodePropertySize(const std::string& offset, const SymbolTable& symbolTable, const Property& property);
+	static std::string encodePropertySize(const std::string& offset, const SymbolTable& symbolTable, const std::string& name, const std::string& type);
+
+	static std::string encodeFlatField(const std::string& offset, const SymbolTable& symbolTable, const Property& property, const std::size_t slot);
+	static std::string encodeFlatAccessorType(const SymbolTable& symbolTable, const std::string& type);
+	static std::string encodeFlatAccessor(const std::string& offset, const SymbolTable& symbolTable, const std::string& type, const std::size_t slot);
+
+	static std::string encodeDeltaField(const std::string& offset, const SymbolTable& symbolTable, const TypeCollection& collection, const bool serialize, const Property& property, const std::size_t index);
+
 	static std::string encodePropertySerializationToJson(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const Property& property);
 	static std::string encodePropertySerializationToJson(const std::string& offset, const SymbolTable& symbolTable, const bool serialize, const std::string& name, const std::string& type);
 	
@@ -75,6 +89,11 @@ private:
 	static std::string toString(const DecoratorType type);
 
 	static bool isValidListType(const SymbolTable& symbolTable, const PropertyType type, const std::string& token);
+	static bool isTriviallyCopyableVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token);
+	static bool isDeltaComparable(const SymbolTable& symbolTable, const std::string& type);
+	static bool isDeltaCopyable(const SymbolTable& symbolTable, const TypeCollection& collection, const std::string& type);
+	static bool isTableVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token);
+	static bool isPointerVector(const SymbolTable& symbolTable, const std::string& type, const std::string& token);
 	static bool isValidMapKeyType(const PropertyType type);
 	static bool isValidMapValueType(const SymbolTable& symbolTable, const PropertyType type, const std::string& token);
 };
\ No newline at end of file
@@ -137,7 +137,7 @@ bool Parser::parseClass(TypeCollection& collection, SymbolTable& symbolTable, Sy
 			|| token == ","
 			) continue;
 
-		if (element->parent != "IType")
+		if (!TypeClass::isRootClass(element->parent))
 		{
 			element->parent = token;
 		}
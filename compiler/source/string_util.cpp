@@ -134,6 +134,17 @@ std::string StringUtil::rtrim(const std::string& str, const char ch)
 	return result;
 }
 
+unsigned long long StringUtil::hash(const std::string& str)
+{
+	unsigned long long hash = 14695981039346656037ull;
+	for (const char c : str)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
 std::vector<std::string> StringUtil::getLines(const std::string& str)
 {
 	std::vector<std::string> lines;
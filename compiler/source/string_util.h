@@ -34,6 +34,9 @@ public:
 	static std::string rtrim(const std::string& str);
 	static std::string rtrim(const std::string& str, char ch);
 
+	// FNV-1a 64 bit hash
+	static unsigned long long hash(const std::string& str);
+
 	// retrieve all the string lines
 	static std::vector<std::string> getLines(const std::string& str);
 };
\ No newline at end of file
@@ -70,4 +70,9 @@ TypeClass* const TypeClass::addProperty(const std::string& memberName, const std
 
 	properties.push_back(prop);
 	return this;
+}
+
+bool TypeClass::isRootClass(const std::string& name)
+{
+	return name == "IType" || name == "ITrackedType";
 }
\ No newline at end of file
@@ -59,6 +59,9 @@ public:
 	bool isStruct{ false };
 
 	TypeClass* const addProperty(const std::string& memberName, const std::string& type, const meta_t& meta);
+
+	// runtime base classes ending the inheritance chain
+	static bool isRootClass(const std::string& name);
 };
 
 class TypeEnum : public Type
@@ -2,19 +2,102 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
+#if defined(_WIN32)
+// only the few Win32 functions used to map files are declared, including windows.h
+// would leak its macros into every source using the runtime
+union _LARGE_INTEGER;
+struct _SECURITY_ATTRIBUTES;
+
+extern "C"
+{
+	__declspec(dllimport) void* __stdcall CreateFileA(const char*, unsigned long, unsigned long, _SECURITY_ATTRIBUTES*, unsigned long, unsigned long, void*);
+	__declspec(dllimport) void* __stdcall CreateFileMappingA(void*, _SECURITY_ATTRIBUTES*, unsigned long, unsigned long, unsigned long, const char*);
+	__declspec(dllimport) int __stdcall GetFileSizeEx(void*, _LARGE_INTEGER*);
+#if defined(_WIN64)
+	__declspec(dllimport) void* __stdcall MapViewOfFile(void*, unsigned long, unsigned long, unsigned long, unsigned __int64);
+#else
+	__declspec(dllimport) void* __stdcall MapViewOfFile(void*, unsigned long, unsigned long, unsigned long, unsigned long);
+#endif
+	__declspec(dllimport) int __stdcall UnmapViewOfFile(const void*);
+	__declspec(dllimport) int __stdcall CloseHandle(void*);
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VDTREFLECT_CRC32C_SSE42
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define VDTREFLECT_TARGET_SSE42
+#else
+#define VDTREFLECT_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#define VDTREFLECT_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VDTREFLECT_JSON_SSE2
+#include <immintrin.h>
+#if defined(__AVX2__)
+#define VDTREFLECT_JSON_AVX2
+#define VDTREFLECT_TARGET_AVX2
+#elif !defined(_MSC_VER)
+#define VDTREFLECT_JSON_AVX2
+#define VDTREFLECT_JSON_AVX2_DISPATCH
+#define VDTREFLECT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace reflect
 {
+	namespace encoding
+	{
+		struct ByteFormat;
+		struct ByteView;
+		class InputByteStream;
+		class OutputByteStream;
+
+		namespace json
+		{
+			class Reader;
+			class Writer;
+		}
+	}
+
 	typedef std::map<std::string, int> enum_values_t;
 
 	template <typename T>
@@ -120,6 +203,8 @@ namespace reflect
 
 	typedef std::map<std::string, std::string> meta_t;
 	typedef unsigned long long member_address_t;
+	// stable numeric identifier of a reflected type, the FNV-1a hash of its qualified name
+	typedef std::uint64_t type_id_t;
 
 	struct PropertyType
 	{
@@ -175,15 +260,26 @@ namespace reflect
 		virtual ~IType() = default;
 
 		virtual void type_initialize() {}
+		virtual type_id_t type_id() const = 0;
 		virtual const char* const type_name() const = 0;
 		virtual const meta_t& type_meta() const = 0;
 		virtual const properties_t& type_properties() const = 0;
 
 		virtual operator std::string() const = 0;
 		virtual void from_string(const std::string& str) = 0;
+		virtual void from_bytes(encoding::InputByteStream& stream) = 0;
+		// decode the bytes following the type id, already read by the caller
+		virtual void from_bytes_body(encoding::InputByteStream& stream) = 0;
+		virtual void to_bytes(encoding::OutputByteStream& stream) const = 0;
+		virtual std::size_t binary_size(const encoding::ByteFormat& format) const = 0;
 		std::string to_string() const { return static_cast<std::string>(*this); }
+		std::string to_string(const encoding::ByteFormat& format) const;
 		virtual void from_json(const std::string& json) = 0;
+		// decode the next value of the reader
+		virtual void from_json(encoding::json::Reader& reader) = 0;
 		virtual std::string to_json(const std::string& offset = "") const = 0;
+		// write the object as the next value of the writer
+		virtual void to_json(encoding::json::Writer& writer) const = 0;
 	};
 
 	template <typename T>
@@ -196,6 +292,8 @@ namespace reflect
 			static meta_t s_meta;
 			return s_meta;
 		}
+		static type_id_t id() { return 0; }
+		static std::uint64_t schema() { return 0; }
 		static const char* const name() { return ""; }
 		static const properties_t& properties()
 		{
@@ -204,13 +302,24 @@ namespace reflect
 		}
 		static std::size_t size() { return sizeof(T); }
 
-		static void from_string(const std::string&, T&) {}
-		static std::string to_string(const T&) { return ""; }
+		static void from_string(const std::string&, T&, const encoding::ByteFormat&) {}
+		static void from_bytes(const encoding::ByteView&, T&, const encoding::ByteFormat&) {}
+		static void read(encoding::InputByteStream&, T&) {}
+		static void read_body(encoding::InputByteStream&, T&) {}
+		static void read_field(encoding::InputByteStream&, T&, const std::uint32_t) {}
+		static std::string to_string(const T&, const encoding::ByteFormat&) { return ""; }
+		static void write(encoding::OutputByteStream&, const T&) {}
+		static std::size_t binary_size(const T&, const encoding::ByteFormat&) { return 0; }
+		static bool write_delta(const T&, const T&, encoding::OutputByteStream&) { return false; }
+		static void apply_delta(const T&, encoding::InputByteStream&, T&) {}
 		static void from_json(const std::string&, T&) {}
+		static void read_json(encoding::json::Reader&, T&) {}
 		static std::string to_json(const T&, const std::string&) { return ""; }
+		static void to_json(encoding::json::Writer&, const T&) {}
 	};
 
 	typedef std::function<IType* const()> constructor_t;
+	typedef std::function<std::shared_ptr<IType>(std::pmr::memory_resource* const)> shared_constructor_t;
 
 	class TypeFactory final
 	{
@@ -233,6 +342,29 @@ namespace reflect
 			return nullptr;
 		}
 
+		static IType* const instantiate(const type_id_t id)
+		{
+			const auto& dictionary = id_collection();
+			const auto& it = dictionary.find(id);
+			if (it != dictionary.end())
+			{
+				return it->second();
+			}
+			return nullptr;
+		}
+
+		// allocate the object and its control block from the given memory resource, the default heap if null
+		static std::shared_ptr<IType> instantiate_shared(const type_id_t id, std::pmr::memory_resource* const resource)
+		{
+			const auto& dictionary = shared_collection();
+			const auto& it = dictionary.find(id);
+			if (it != dictionary.end())
+			{
+				return it->second(resource);
+			}
+			return nullptr;
+		}
+
 		template <typename T = IType>
 		static T* const instantiate()
 		{
@@ -245,6 +377,18 @@ namespace reflect
 			return reinterpret_cast<T*>(instantiate(name));
 		}
 
+		template <typename T = IType>
+		static T* const instantiate(const type_id_t id)
+		{
+			return reinterpret_cast<T*>(instantiate(id));
+		}
+
+		template <typename T = IType>
+		static std::shared_ptr<T> instantiate_shared(const type_id_t id, std::pmr::memory_resource* const resource)
+		{
+			return std::dynamic_pointer_cast<T>(instantiate_shared(id, resource));
+		}
+
 		static const std::map<std::string, std::tuple<meta_t, constructor_t>>& list()
 		{
 			return collection();
@@ -277,6 +421,18 @@ namespace reflect
 			return s_getters;
 		}
 
+		static std::unordered_map<type_id_t, constructor_t>& id_collection()
+		{
+			static std::unordered_map<type_id_t, constructor_t> s_getters;
+			return s_getters;
+		}
+
+		static std::unordered_map<type_id_t, shared_constructor_t>& shared_collection()
+		{
+			static std::unordered_map<type_id_t, shared_constructor_t> s_getters;
+			return s_getters;
+		}
+
 		static const std::tuple<meta_t, constructor_t>& definition(const std::string& name)
 		{
 			static std::tuple<meta_t, constructor_t> s_empty_definition;
@@ -289,8 +445,13 @@ namespace reflect
 			return s_empty_definition;
 		}
 
-		static bool insert(const std::string& name, const meta_t& meta, constructor_t&& constructor)
+		static bool insert(const std::string& name, const type_id_t id, const meta_t& meta, constructor_t&& constructor, shared_constructor_t&& shared_constructor)
 		{
+			const bool unique = id_collection().insert(std::make_pair(id, constructor)).second;
+			// the compiler rejects the types of a project sharing an id, this catches the ones generated apart
+			assert(unique && "Two registered types have the same type id");
+			static_cast<void>(unique);
+			shared_collection().insert(std::make_pair(id, std::move(shared_constructor)));
 			return collection().insert(std::make_pair(name, std::make_tuple(meta, constructor))), true;
 		}
 	};
@@ -302,175 +463,3432 @@ namespace reflect
 	};
 	
 	template <typename T>
-	bool RegisteredInTypeFactory<T>::type_registered{ TypeFactory::insert(Type<T>::name(), Type<T>::meta(), std::bind(&Type<T>::instantiate)) };
+	bool RegisteredInTypeFactory<T>::type_registered{ TypeFactory::insert(Type<T>::name(), Type<T>::id(), Type<T>::meta(), std::bind(&Type<T>::instantiate), &Type<T>::instantiate_shared) };
 
 	namespace encoding
 	{
 		typedef std::vector<std::byte> ByteBuffer;
 
-		struct ByteBufferFile
+		// The MappedByteBuffer maps a file read-only in memory.
+		// Pages are loaded on first access and shared with the other processes reading the same file,
+		// the bytes are never copied into the process.
+
+		class MappedByteBuffer
 		{
-			static bool load(ByteBuffer& buffer, const char* const path)
+		public:
+			MappedByteBuffer() = default;
+
+			MappedByteBuffer(const char* const path)
 			{
-				buffer.clear();
-				buffer.resize(0);
-				buffer.shrink_to_fit();
+				open(path);
+			}
 
-				std::ifstream file(path, std::ios::in | std::ios_base::binary);
-				if (!file.is_open() || file.bad())
+			MappedByteBuffer(const MappedByteBuffer&) = delete;
+			MappedByteBuffer& operator=(const MappedByteBuffer&) = delete;
+
+			MappedByteBuffer(MappedByteBuffer&& other) noexcept
+				: m_data{ other.m_data }
+				, m_size{ other.m_size }
+				, m_open{ other.m_open }
+			{
+				other.m_data = nullptr;
+				other.m_size = 0;
+				other.m_open = false;
+			}
+
+			MappedByteBuffer& operator=(MappedByteBuffer&& other) noexcept
+			{
+				if (this != &other)
+				{
+					close();
+					std::swap(m_data, other.m_data);
+					std::swap(m_size, other.m_size);
+					std::swap(m_open, other.m_open);
+				}
+				return *this;
+			}
+
+			~MappedByteBuffer()
+			{
+				close();
+			}
+
+			bool open(const char* const path)
+			{
+				close();
+
+#if defined(_WIN32)
+				void* const file = ::CreateFileA(path, generic_read, file_share_read, nullptr, open_existing, file_attribute_normal, nullptr);
+				if (file == reinterpret_cast<void*>(static_cast<std::intptr_t>(-1)))
 					return false;
 
-				// Clear whitespace removal flag
-				file.unsetf(std::ios::skipws);
+				// the LARGE_INTEGER union only wraps the 64 bits size
+				long long file_size = 0;
+				if (!::GetFileSizeEx(file, reinterpret_cast<_LARGE_INTEGER*>(&file_size)))
+				{
+					::CloseHandle(file);
+					return false;
+				}
 
-				// Determine size of the file
-				file.seekg(0, std::ios_base::end);
-				const std::size_t file_size = file.tellg();
-				file.seekg(0, std::ios_base::beg);
+				// empty files can't be mapped
+				if (file_size > 0)
+				{
+					void* const mapping = ::CreateFileMappingA(file, nullptr, page_readonly, 0, 0, nullptr);
+					if (mapping != nullptr)
+					{
+						m_data = static_cast<const std::byte*>(::MapViewOfFile(mapping, file_map_read, 0, 0, 0));
+						::CloseHandle(mapping);
+					}
+					if (m_data == nullptr)
+					{
+						::CloseHandle(file);
+						return false;
+					}
+				}
+				::CloseHandle(file);
+				m_size = static_cast<std::size_t>(file_size);
+#else
+				const int file = ::open(path, O_RDONLY);
+				if (file < 0)
+					return false;
 
-				buffer.resize(file_size);
-				file.read(reinterpret_cast<char*>(&buffer[0]), file_size);
+				struct stat info;
+				if (fstat(file, &info) != 0)
+				{
+					::close(file);
+					return false;
+				}
 
-				return buffer.size() == file_size;
+				// empty files can't be mapped
+				if (info.st_size > 0)
+				{
+					void* const data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+					if (data == MAP_FAILED)
+					{
+						::close(file);
+						return false;
+					}
+					m_data = static_cast<const std::byte*>(data);
+				}
+				::close(file);
+				m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+				m_open = true;
+				return true;
 			}
 
-			static void save(const ByteBuffer& buffer, const char* const path)
+			void close()
 			{
-				if (buffer.empty()) return;
-
-				std::ofstream file(path, std::ios::out | std::ios_base::binary);
-				file.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size());
-				file.flush();
-				file.close();
+				if (m_data != nullptr)
+				{
+#if defined(_WIN32)
+					::UnmapViewOfFile(m_data);
+#else
+					munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+				}
+				m_data = nullptr;
+				m_size = 0;
+				m_open = false;
 			}
+
+			inline bool isOpen() const { return m_open; }
+			inline const std::byte* data() const { return m_data; }
+			inline std::size_t size() const { return m_size; }
+
+		private:
+#if defined(_WIN32)
+			static constexpr unsigned long generic_read = 0x80000000;
+			static constexpr unsigned long file_share_read = 0x00000001;
+			static constexpr unsigned long open_existing = 3;
+			static constexpr unsigned long file_attribute_normal = 0x00000080;
+			static constexpr unsigned long page_readonly = 0x02;
+			static constexpr unsigned long file_map_read = 0x0004;
+#endif
+
+			const std::byte* m_data{ nullptr };
+			std::size_t m_size{ 0 };
+			bool m_open{ false };
 		};
 
-		class ByteStream
+		// The ByteView is a non-owning reference to a sequence of bytes,
+		// it lets the decoders work on buffers and strings without copying them.
+
+		struct ByteView
 		{
-		public:
-			ByteStream(ByteBuffer& buffer)
-				: m_buffer{ buffer }
+			ByteView(const std::byte* const data, const std::size_t size)
+				: data{ data }
+				, size{ size }
 			{}
 
-			inline const ByteBuffer& getBuffer() const { return m_buffer; }
-			inline const std::byte* getNativeBuffer() const { return m_buffer.data(); }
+			ByteView(const ByteBuffer& buffer)
+				: data{ buffer.data() }
+				, size{ buffer.size() }
+			{}
 
-		protected:
-			// buffer of bytes
-			ByteBuffer& m_buffer;
+			ByteView(const MappedByteBuffer& buffer)
+				: data{ buffer.data() }
+				, size{ buffer.size() }
+			{}
+
+			ByteView(const std::string& str)
+				: data{ reinterpret_cast<const std::byte*>(str.data()) }
+				, size{ str.size() }
+			{}
+
+			const std::byte* const data;
+			const std::size_t size;
 		};
 
-		// The OutputByteBuffer wraps the ByteBuffer.
-		// It has methods for writing sequentially into the buffer.
+		// The Crc32c computes the Castagnoli CRC of a byte sequence.
+		// It uses the crc32 instruction of SSE 4.2 when the CPU has it, checked once at run time,
+		// or the ARMv8 one when the target has it, and a slicing-by-8 table otherwise.
 
-		class OutputByteStream : public ByteStream
+		struct Crc32c
 		{
-		public:
-			OutputByteStream(ByteBuffer& buffer)
-				: ByteStream(buffer)
-			{}
+			static constexpr std::uint32_t polynomial = 0x82f63b78;
 
-			template<typename T>
-			OutputByteStream& operator<< (const T data)
+			static std::uint32_t compute(const ByteView& view)
 			{
-				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
-					"Generic write only supports primitive data type");
+				return update(0, view.data, view.size);
+			}
 
-				const std::byte* begin = reinterpret_cast<const std::byte*>(std::addressof(data));
-				const std::byte* end = begin + sizeof(T);
+			// continue the crc of the bytes before, 0 for the first ones
+			static std::uint32_t update(const std::uint32_t crc, const std::byte* const data, const std::size_t size)
+			{
+#if defined(VDTREFLECT_CRC32C_SSE42)
+				static const bool s_hardware = hasHardware();
+				if (s_hardware)
+				{
+					return ~updateHardware(~crc, data, size);
+				}
+#elif defined(VDTREFLECT_CRC32C_ARM)
+				return ~updateHardware(~crc, data, size);
+#endif
+				return ~updateSoftware(~crc, data, size);
+			}
 
-				m_buffer.insert(m_buffer.end(), begin, end);
+		private:
+#if defined(VDTREFLECT_CRC32C_SSE42)
+			static bool hasHardware()
+			{
+#if defined(_MSC_VER)
+				int info[4];
+				__cpuid(info, 1);
+				return (info[2] & (1 << 20)) != 0;
+#else
+				return __builtin_cpu_supports("sse4.2");
+#endif
+			}
 
-				return *this;
+			VDTREFLECT_TARGET_SSE42 static std::uint32_t updateHardware(std::uint32_t crc, const std::byte* data, std::size_t size)
+			{
+				std::uint64_t value = crc;
+				for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), data += sizeof(std::uint64_t))
+				{
+					std::uint64_t word;
+					std::memcpy(&word, data, sizeof(std::uint64_t));
+					value = _mm_crc32_u64(value, word);
+				}
+				crc = static_cast<std::uint32_t>(value);
+				for (; size > 0; --size, ++data)
+				{
+					crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(*data));
+				}
+				return crc;
+			}
+#elif defined(VDTREFLECT_CRC32C_ARM)
+			static std::uint32_t updateHardware(std::uint32_t crc, const std::byte* data, std::size_t size)
+			{
+				for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), data += sizeof(std::uint64_t))
+				{
+					std::uint64_t word;
+					std::memcpy(&word, data, sizeof(std::uint64_t));
+					crc = __crc32cd(crc, word);
+				}
+				for (; size > 0; --size, ++data)
+				{
+					crc = __crc32cb(crc, static_cast<std::uint8_t>(*data));
+				}
+				return crc;
 			}
+#endif
 
-			OutputByteStream& operator<< (const std::string& data)
+			typedef std::uint32_t table_t[8][256];
+
+			static const table_t& table()
 			{
-				*this << data.size();
+				static const struct Table
+				{
+					Table()
+					{
+						for (std::uint32_t i = 0; i < 256; ++i)
+						{
+							std::uint32_t crc = i;
+							for (int bit = 0; bit < 8; ++bit)
+							{
+								crc = (crc >> 1) ^ ((crc & 1) != 0 ? polynomial : 0);
+							}
+							values[0][i] = crc;
+						}
+						for (std::uint32_t i = 0; i < 256; ++i)
+						{
+							for (int slice = 1; slice < 8; ++slice)
+							{
+								values[slice][i] = (values[slice - 1][i] >> 8) ^ values[0][values[slice - 1][i] & 0xff];
+							}
+						}
+					}
+
+					table_t values;
+				} s_table;
+				return s_table.values;
+			}
+
+			// the words are read as little endian, as the crc is reflected
+			static std::uint32_t updateSoftware(std::uint32_t crc, const std::byte* data, std::size_t size)
+			{
+				const table_t& t = table();
+				for (; size >= 8; size -= 8, data += 8)
+				{
+					const std::uint32_t low = crc
+						^ (static_cast<std::uint32_t>(data[0]) | static_cast<std::uint32_t>(data[1]) << 8
+							| static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24);
+					crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+						^ t[3][static_cast<std::uint8_t>(data[4])] ^ t[2][static_cast<std::uint8_t>(data[5])]
+						^ t[1][static_cast<std::uint8_t>(data[6])] ^ t[0][static_cast<std::uint8_t>(data[7])];
+				}
+				for (; size > 0; --size, ++data)
+				{
+					crc = (crc >> 8) ^ t[0][(crc ^ static_cast<std::uint8_t>(*data)) & 0xff];
+				}
+				return crc;
+			}
+		};
 
-				std::transform(
-					std::begin(data),
-					std::end(data),
-					std::back_inserter(m_buffer),
-					[](const char c)
+		// The Lz codec is a byte oriented LZ77 compressor without entropy coding, in the spirit of LZ4.
+		// A block is a sequence of literal runs and back-references of at least min_match bytes:
+		// token (literal length << 4 | match length - min_match), literals, 16 bit offset.
+		// Length nibbles of 15 continue with bytes of 255 until a smaller one.
+		// The framed form splits the data in blocks, each one stored raw when it does not shrink:
+		// magic | (raw size, stored size, bytes)... | raw size 0
+
+		struct Lz
+		{
+			static constexpr std::uint32_t magic = 0x5a544456; // VDTZ
+			static constexpr std::size_t block_size = 64 * 1024;
+			static constexpr std::size_t min_match = 4;
+			static constexpr std::size_t max_offset = 0xffff;
+			static constexpr unsigned int hash_bits = 14;
+
+			// the largest compressed size of a block of the given size
+			static constexpr std::size_t bound(const std::size_t size)
+			{
+				return size + size / 255 + 16;
+			}
+
+			// compress a block into dst, of at least bound(size) bytes, and return the compressed size
+			static std::size_t compressBlock(const std::byte* const src, const std::size_t size, std::byte* const dst)
+			{
+				std::vector<std::uint32_t> table(std::size_t{ 1 } << hash_bits, 0);
+				std::byte* out = dst;
+				std::size_t anchor = 0;
+				std::size_t position = 0;
+
+				while (position + min_match <= size)
+				{
+					const std::uint32_t sequence = read32(src + position);
+					std::uint32_t& slot = table[hash(sequence)];
+					const std::size_t candidate = slot;
+					slot = static_cast<std::uint32_t>(position);
+
+					if (candidate >= position || position - candidate > max_offset || read32(src + candidate) != sequence)
 					{
-						return std::byte(c);
+						// skip faster over the data that does not compress
+						position += 1 + ((position - anchor) >> 6);
+						continue;
 					}
-				);
 
-				return *this;
+					std::size_t length = min_match;
+					while (position + length < size && src[candidate + length] == src[position + length])
+					{
+						++length;
+					}
+
+					std::byte* const token = out;
+					out = writeSequence(out, src + anchor, position - anchor);
+					const std::size_t offset = position - candidate;
+					*out++ = static_cast<std::byte>(offset & 0xff);
+					*out++ = static_cast<std::byte>(offset >> 8);
+
+					const std::size_t extra = length - min_match;
+					*token |= static_cast<std::byte>((std::min<std::size_t>)(extra, 15));
+					if (extra >= 15)
+					{
+						out = writeLength(out, extra - 15);
+					}
+
+					position += length;
+					anchor = position;
+				}
+
+				if (anchor < size)
+				{
+					out = writeSequence(out, src + anchor, size - anchor);
+				}
+				return static_cast<std::size_t>(out - dst);
 			}
 
-			OutputByteStream& operator<< (const char* str)
+			// decompress a block into dst, return false if it is malformed or larger than the capacity
+			static bool decompressBlock(const std::byte* const src, const std::size_t size, std::byte* const dst, const std::size_t capacity, std::size_t& written)
 			{
-				const std::size_t size = std::strlen(str);
-				*this << size;
+				const std::byte* in = src;
+				const std::byte* const end = src + size;
+				std::size_t out = 0;
 
-				const std::byte* begin = reinterpret_cast<const std::byte*>(str);
-				const std::byte* end = begin + size;
+				while (in < end)
+				{
+					const std::size_t token = static_cast<std::size_t>(*in++);
+
+					std::size_t literals = token >> 4;
+					if (literals == 15 && !readLength(in, end, literals)) return false;
+					if (literals > static_cast<std::size_t>(end - in) || literals > capacity - out) return false;
+					std::memcpy(dst + out, in, literals);
+					in += literals;
+					out += literals;
+
+					// the last sequence has no match
+					if (in == end) break;
+
+					if (end - in < 2) return false;
+					const std::size_t offset = static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8);
+					in += 2;
+					if (offset == 0 || offset > out) return false;
+
+					std::size_t length = token & 0x0f;
+					if (length == 15 && !readLength(in, end, length)) return false;
+					length += min_match;
+					if (length > capacity - out) return false;
+
+					// the match may overlap the bytes it produces
+					const std::byte* match = dst + out - offset;
+					if (offset >= length)
+					{
+						std::memcpy(dst + out, match, length);
+					}
+					else
+					{
+						for (std::size_t i = 0; i < length; ++i)
+						{
+							dst[out + i] = match[i];
+						}
+					}
+					out += length;
+				}
 
-				m_buffer.insert(m_buffer.end(), begin, end);
+				written = out;
+				return true;
+			}
 
-				return *this;
+			// compress the view in framed blocks, appending to the output
+			static void compress(const ByteView& view, ByteBuffer& output, const std::size_t block = block_size)
+			{
+				append(output, magic);
+				for (std::size_t position = 0; position < view.size; position += block)
+				{
+					const std::size_t size = (std::min)(block, view.size - position);
+					appendFrame(output, view.data + position, size);
+				}
+				append(output, std::uint32_t{ 0 });
 			}
-		};
 
-		// The InputByteStream has methods for reading sequentially from the buffer. 
+			// decompress framed blocks, appending to the output, return false if the data is malformed
+			static bool decompress(const ByteView& view, ByteBuffer& output)
+			{
+				std::size_t position = 0;
+				std::uint32_t value{ 0 };
+				if (!read(view, position, value) || value != magic) return false;
 
-		class InputByteStream : public ByteStream
-		{
-		public:
-			InputByteStream(ByteBuffer& buffer)
-				: ByteStream(buffer)
-				, m_index{ 0 }
-			{}
+				while (true)
+				{
+					std::uint32_t raw{ 0 };
+					std::uint32_t stored{ 0 };
+					if (!read(view, position, raw)) return false;
+					if (raw == 0) return true;
+					if (!read(view, position, stored) || stored > view.size - position || !isValidFrame(raw, stored)) return false;
+
+					const std::size_t offset = output.size();
+					output.resize(offset + raw);
+					if (!decodeFrame(view.data + position, stored, output.data() + offset, raw)) return false;
+					position += stored;
+				}
+			}
 
-			InputByteStream(ByteBuffer& buffer, const std::size_t index)
-				: ByteStream(buffer)
-				, m_index(index)
-			{}
+			// write a block as a frame, raw if it does not shrink
+			static void appendFrame(ByteBuffer& output, const std::byte* const data, const std::size_t size)
+			{
+				const std::size_t header = output.size();
+				append(output, static_cast<std::uint32_t>(size));
+				append(output, static_cast<std::uint32_t>(size));
+
+				const std::size_t offset = output.size();
+				output.resize(offset + bound(size));
+				const std::size_t stored = compressBlock(data, size, output.data() + offset);
+				if (stored < size)
+				{
+					output.resize(offset + stored);
+					const std::uint32_t value = static_cast<std::uint32_t>(stored);
+					std::memcpy(output.data() + header + sizeof(std::uint32_t), &value, sizeof(std::uint32_t));
+				}
+				else
+				{
+					std::memcpy(output.data() + offset, data, size);
+					output.resize(offset + size);
+				}
+			}
 
-			template<typename T>
-			InputByteStream& operator>> (T& data)
+			// a sequence outputs at most 255 bytes per byte it takes,
+			// checked before allocating the raw size of a frame read from untrusted data
+			static constexpr bool isValidFrame(const std::size_t raw, const std::size_t stored)
 			{
-				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
-					"Generic read only supports primitive data type");
+				return stored <= raw && raw <= stored * 255;
+			}
+
+			// decode the bytes of a frame, stored raw when they have the raw size
+			static bool decodeFrame(const std::byte* const data, const std::size_t stored, std::byte* const dst, const std::size_t raw)
+			{
+				if (stored == raw)
+				{
+					std::memcpy(dst, data, raw);
+					return true;
+				}
+
+				std::size_t written{ 0 };
+				return decompressBlock(data, stored, dst, raw, written) && written == raw;
+			}
+
+		private:
+			static std::uint32_t read32(const std::byte* const data)
+			{
+				std::uint32_t value;
+				std::memcpy(&value, data, sizeof(std::uint32_t));
+				return value;
+			}
+
+			static std::size_t hash(const std::uint32_t sequence)
+			{
+				return (sequence * 2654435761u) >> (32 - hash_bits);
+			}
+
+			// write the token and the literals of a sequence, the match length is added to the token later
+			static std::byte* writeSequence(std::byte* out, const std::byte* const literals, const std::size_t count)
+			{
+				*out++ = static_cast<std::byte>((std::min<std::size_t>)(count, 15) << 4);
+				if (count >= 15)
+				{
+					out = writeLength(out, count - 15);
+				}
+				std::memcpy(out, literals, count);
+				return out + count;
+			}
+
+			static std::byte* writeLength(std::byte* out, std::size_t length)
+			{
+				while (length >= 255)
+				{
+					*out++ = std::byte{ 255 };
+					length -= 255;
+				}
+				*out++ = static_cast<std::byte>(length);
+				return out;
+			}
+
+			static bool readLength(const std::byte*& in, const std::byte* const end, std::size_t& length)
+			{
+				while (in < end)
+				{
+					const std::size_t value = static_cast<std::size_t>(*in++);
+					length += value;
+					if (value != 255) return true;
+				}
+				return false;
+			}
+
+			static void append(ByteBuffer& output, const std::uint32_t value)
+			{
+				const std::byte* data = reinterpret_cast<const std::byte*>(&value);
+				output.insert(output.end(), data, data + sizeof(std::uint32_t));
+			}
+
+			static bool read(const ByteView& view, std::size_t& position, std::uint32_t& value)
+			{
+				if (view.size - position < sizeof(std::uint32_t)) return false;
+				std::memcpy(&value, view.data + position, sizeof(std::uint32_t));
+				position += sizeof(std::uint32_t);
+				return true;
+			}
+		};
+
+		// The LzOutputStreamBuffer compresses the bytes written through it in framed blocks.
+		// It turns any std::ostream into a compressed sink, for instance the one of a streamed OutputByteStream:
+		// std::ostream compressed(&lz); OutputByteStream stream(buffer, compressed, format);
+
+		class LzOutputStreamBuffer : public std::streambuf
+		{
+		public:
+			LzOutputStreamBuffer(std::ostream& sink, const std::size_t block = Lz::block_size)
+				: m_sink{ sink }
+				, m_block((std::max<std::size_t>)(block, 1))
+			{
+				char* const begin = reinterpret_cast<char*>(m_block.data());
+				setp(begin, begin + m_block.size());
+			}
+
+			LzOutputStreamBuffer(const LzOutputStreamBuffer&) = delete;
+			LzOutputStreamBuffer& operator=(const LzOutputStreamBuffer&) = delete;
+
+			~LzOutputStreamBuffer()
+			{
+				finish();
+			}
+
+			// compress the pending bytes and write the end marker, nothing can be written afterwards
+			void finish()
+			{
+				if (m_finished) return;
+
+				writeFrame();
+				const std::uint32_t end{ 0 };
+				m_frame.clear();
+				writeHeader();
+				m_frame.insert(m_frame.end(), reinterpret_cast<const std::byte*>(&end), reinterpret_cast<const std::byte*>(&end) + sizeof(std::uint32_t));
+				m_sink.write(reinterpret_cast<const char*>(m_frame.data()), m_frame.size());
+				m_sink.flush();
+				m_finished = true;
+			}
+
+		protected:
+			int_type overflow(const int_type ch) override
+			{
+				if (m_finished) return traits_type::eof();
+
+				writeFrame();
+				if (!traits_type::eq_int_type(ch, traits_type::eof()))
+				{
+					*pptr() = traits_type::to_char_type(ch);
+					pbump(1);
+				}
+				return traits_type::not_eof(ch);
+			}
+
+			// every sync closes the current block
+			int sync() override
+			{
+				if (m_finished) return 0;
+
+				writeFrame();
+				m_sink.flush();
+				return m_sink ? 0 : -1;
+			}
+
+		private:
+			void writeHeader()
+			{
+				if (m_started) return;
+
+				const std::uint32_t magic = Lz::magic;
+				m_frame.insert(m_frame.begin(), reinterpret_cast<const std::byte*>(&magic), reinterpret_cast<const std::byte*>(&magic) + sizeof(std::uint32_t));
+				m_started = true;
+			}
+
+			void writeFrame()
+			{
+				const std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+				if (size == 0) return;
+
+				m_frame.clear();
+				Lz::appendFrame(m_frame, m_block.data(), size);
+				writeHeader();
+				m_sink.write(reinterpret_cast<const char*>(m_frame.data()), m_frame.size());
+
+				char* const begin = reinterpret_cast<char*>(m_block.data());
+				setp(begin, begin + m_block.size());
+			}
+
+			std::ostream& m_sink;
+			ByteBuffer m_block;
+			ByteBuffer m_frame;
+			bool m_started{ false };
+			bool m_finished{ false };
+		};
+
+		// The LzInputStreamBuffer decompresses the framed blocks read from a source,
+		// the counterpart of the LzOutputStreamBuffer for a streamed InputByteStream.
+
+		class LzInputStreamBuffer : public std::streambuf
+		{
+		public:
+			LzInputStreamBuffer(std::istream& source)
+				: m_source{ source }
+			{}
+
+			LzInputStreamBuffer(const LzInputStreamBuffer&) = delete;
+			LzInputStreamBuffer& operator=(const LzInputStreamBuffer&) = delete;
+
+			// false once the source turned out to be malformed or truncated
+			inline bool isValid() const { return m_valid; }
+
+		protected:
+			int_type underflow() override
+			{
+				if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+				if (!readFrame()) return traits_type::eof();
+				return traits_type::to_int_type(*gptr());
+			}
+
+		private:
+			bool readValue(std::uint32_t& value)
+			{
+				m_source.read(reinterpret_cast<char*>(&value), sizeof(std::uint32_t));
+				return m_source.gcount() == sizeof(std::uint32_t);
+			}
+
+			bool readFrame()
+			{
+				if (m_ended || !m_valid) return false;
+
+				std::uint32_t raw{ 0 };
+				std::uint32_t stored{ 0 };
+				if (!m_started)
+				{
+					m_started = true;
+					std::uint32_t magic{ 0 };
+					m_valid = readValue(magic) && magic == Lz::magic;
+					if (!m_valid) return false;
+				}
+				if (!readValue(raw))
+				{
+					m_valid = false;
+					return false;
+				}
+				if (raw == 0)
+				{
+					m_ended = true;
+					return false;
+				}
+				if (!readValue(stored) || !Lz::isValidFrame(raw, stored))
+				{
+					m_valid = false;
+					return false;
+				}
+
+				m_frame.resize(stored);
+				m_source.read(reinterpret_cast<char*>(m_frame.data()), stored);
+				m_block.resize(raw);
+				m_valid = static_cast<std::size_t>(m_source.gcount()) == stored
+					&& Lz::decodeFrame(m_frame.data(), stored, m_block.data(), raw);
+				if (!m_valid) return false;
+
+				char* const begin = reinterpret_cast<char*>(m_block.data());
+				setg(begin, begin, begin + m_block.size());
+				return true;
+			}
+
+			std::istream& m_source;
+			ByteBuffer m_frame;
+			ByteBuffer m_block;
+			bool m_started{ false };
+			bool m_ended{ false };
+			bool m_valid{ true };
+		};
+
+		struct ByteBufferFile
+		{
+			static bool load(ByteBuffer& buffer, const char* const path)
+			{
+				buffer.clear();
+				buffer.resize(0);
+				buffer.shrink_to_fit();
+
+				std::ifstream file(path, std::ios::in | std::ios_base::binary);
+				if (!file.is_open() || file.bad())
+					return false;
+
+				// Clear whitespace removal flag
+				file.unsetf(std::ios::skipws);
+
+				// Determine size of the file
+				file.seekg(0, std::ios_base::end);
+				const std::size_t file_size = file.tellg();
+				file.seekg(0, std::ios_base::beg);
+
+				buffer.resize(file_size);
+				file.read(reinterpret_cast<char*>(&buffer[0]), file_size);
+
+				return buffer.size() == file_size;
+			}
+
+			static void save(const ByteBuffer& buffer, const char* const path)
+			{
+				if (buffer.empty()) return;
+
+				std::ofstream file(path, std::ios::out | std::ios_base::binary);
+				file.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size());
+				file.flush();
+				file.close();
+			}
+
+			// the trailer of the files written by saveChecked: crc32c of the content, magic
+			static constexpr std::uint32_t checked_magic = 0x43544456; // VDTC
+			static constexpr std::size_t trailer_size = sizeof(std::uint32_t) + sizeof(std::uint32_t);
+
+			// load a file written by saveChecked, false if it is truncated or corrupted
+			// the checksum is computed chunk by chunk while the bytes are still in cache
+			static bool loadChecked(ByteBuffer& buffer, const char* const path, const std::size_t chunk = 64 * 1024)
+			{
+				buffer.clear();
+
+				std::ifstream file(path, std::ios::in | std::ios_base::binary);
+				if (!file.is_open() || file.bad())
+					return false;
+
+				file.seekg(0, std::ios_base::end);
+				const std::size_t file_size = file.tellg();
+				file.seekg(0, std::ios_base::beg);
+				if (file_size < trailer_size) return false;
+
+				const std::size_t size = file_size - trailer_size;
+				buffer.resize(file_size);
+				std::uint32_t crc{ 0 };
+				for (std::size_t position = 0; position < size; position += chunk)
+				{
+					const std::size_t amount = (std::min)(chunk, size - position);
+					file.read(reinterpret_cast<char*>(buffer.data() + position), amount);
+					if (static_cast<std::size_t>(file.gcount()) != amount) return false;
+					crc = Crc32c::update(crc, buffer.data() + position, amount);
+				}
+
+				std::uint32_t checksum{ 0 }, magic{ 0 };
+				file.read(reinterpret_cast<char*>(&checksum), sizeof(std::uint32_t));
+				file.read(reinterpret_cast<char*>(&magic), sizeof(std::uint32_t));
+				buffer.resize(size);
+				return file.gcount() == sizeof(std::uint32_t) && magic == checked_magic && checksum == crc;
+			}
+
+			static void saveChecked(const ByteBuffer& buffer, const char* const path)
+			{
+				const std::uint32_t checksum = Crc32c::compute(ByteView(buffer));
+				const std::uint32_t magic = checked_magic;
+
+				std::ofstream file(path, std::ios::out | std::ios_base::binary);
+				file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+				file.write(reinterpret_cast<const char*>(&checksum), sizeof(std::uint32_t));
+				file.write(reinterpret_cast<const char*>(&magic), sizeof(std::uint32_t));
+				file.flush();
+				file.close();
+			}
+
+			// load a file written by saveCompressed
+			static bool loadCompressed(ByteBuffer& buffer, const char* const path)
+			{
+				ByteBuffer compressed;
+				if (!load(compressed, path)) return false;
+
+				buffer.clear();
+				return Lz::decompress(ByteView(compressed), buffer);
+			}
+
+			static void saveCompressed(const ByteBuffer& buffer, const char* const path)
+			{
+				if (buffer.empty()) return;
+
+				ByteBuffer compressed;
+				Lz::compress(ByteView(buffer), compressed);
+				save(compressed, path);
+			}
+		};
+
+		// The ByteFormat selects the wire format of a stream.
+		// Writer and reader must agree on it, it is not stored in the payload.
+		// Tagged and references can't be combined: the objects inside the fields skipped by a reader
+		// would never be registered, and the references that follow would point to the wrong ones.
+
+		struct ByteFormat
+		{
+			// LEB128 varints for sizes, enums and integers, zigzag for signed values
+			bool compact{ false };
+			// every property carries a tag and a size, so readers can skip the fields they don't know
+			bool tagged{ false };
+			// objects owned by several shared_ptr are written once, the other owners refer to them
+			bool references{ false };
+
+			inline bool isValid() const { return !(tagged && references); }
+		};
+
+		// LEB128 variable length integers, signed values are zigzag encoded
+
+		struct Varint final
+		{
+			Varint() = delete;
+			~Varint() = delete;
+
+			static constexpr std::size_t max_size = 10;
+
+			// integers and enums wider than one byte are written as varints in compact format
+			template <typename T>
+			static constexpr bool supports()
+			{
+				return (std::is_integral<T>::value || std::is_enum<T>::value) && sizeof(T) > 1;
+			}
+
+			template <typename T>
+			static std::uint64_t encode(const T value)
+			{
+				if constexpr (std::is_enum<T>::value)
+				{
+					return encode(static_cast<typename std::underlying_type<T>::type>(value));
+				}
+				else if constexpr (std::is_signed<T>::value)
+				{
+					const std::int64_t temp = value;
+					return (static_cast<std::uint64_t>(temp) << 1) ^ static_cast<std::uint64_t>(temp >> 63);
+				}
+				else
+				{
+					return static_cast<std::uint64_t>(value);
+				}
+			}
+
+			template <typename T>
+			static T decode(const std::uint64_t value)
+			{
+				if constexpr (std::is_enum<T>::value)
+				{
+					return static_cast<T>(decode<typename std::underlying_type<T>::type>(value));
+				}
+				else if constexpr (std::is_signed<T>::value)
+				{
+					return static_cast<T>(static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1)));
+				}
+				else
+				{
+					return static_cast<T>(value);
+				}
+			}
+
+			static std::size_t size(std::uint64_t value)
+			{
+				std::size_t size = 1;
+				while (value >= 0x80)
+				{
+					value >>= 7;
+					++size;
+				}
+				return size;
+			}
+
+			// write the value at the given address and return the number of bytes written
+			static std::size_t write(std::byte* const data, std::uint64_t value)
+			{
+				std::size_t size = 0;
+				while (value >= 0x80)
+				{
+					data[size++] = std::byte(static_cast<unsigned char>(value | 0x80));
+					value >>= 7;
+				}
+				data[size++] = std::byte(static_cast<unsigned char>(value));
+				return size;
+			}
+		};
+
+		class ByteStream
+		{
+		public:
+			ByteStream(ByteBuffer& buffer, const ByteFormat& format)
+				: m_buffer{ buffer }
+				, m_format{ format }
+			{
+				assert(format.isValid() && "Tagged streams can't use references");
+			}
+
+			inline const ByteBuffer& getBuffer() const { return m_buffer; }
+			inline const std::byte* getNativeBuffer() const { return m_buffer.data(); }
+			inline const ByteFormat& getFormat() const { return m_format; }
+
+		protected:
+			// buffer of bytes
+			ByteBuffer& m_buffer;
+			// wire format
+			ByteFormat m_format;
+		};
+
+		// The OutputByteBuffer wraps the ByteBuffer.
+		// It has methods for writing sequentially into the buffer.
+		// When a sink is given, the buffer is a staging chunk flushed to the sink as it fills up,
+		// so arbitrarily large payloads are written with bounded memory.
+
+		class OutputByteStream : public ByteStream
+		{
+		public:
+			static constexpr std::size_t chunk_size = 64 * 1024;
+
+			OutputByteStream(ByteBuffer& buffer, const ByteFormat& format = {})
+				: ByteStream(buffer, format)
+			{}
+
+			OutputByteStream(ByteBuffer& buffer, std::ostream& sink, const ByteFormat& format = {}, const std::size_t chunk = chunk_size)
+				: ByteStream(buffer, format)
+				, m_sink{ &sink }
+				, m_chunk{ chunk }
+			{}
+
+			~OutputByteStream()
+			{
+				flush();
+			}
+
+			template<typename T>
+			OutputByteStream& operator<< (const T data)
+			{
+				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
+					"Generic write only supports primitive data type");
+
+				if constexpr (Varint::supports<T>())
+				{
+					if (m_format.compact)
+					{
+						return writeVarint(Varint::encode(data));
+					}
+				}
+
+				return writeFixed(data);
+			}
+
+			OutputByteStream& operator<< (const std::string& data)
+			{
+				*this << data.size();
+
+				const std::byte* begin = reinterpret_cast<const std::byte*>(data.data());
+				const std::byte* end = begin + data.size();
+
+				append(begin, end);
+
+				return *this;
+			}
+
+			OutputByteStream& operator<< (const char* str)
+			{
+				const std::size_t size = std::strlen(str);
+				*this << size;
+
+				const std::byte* begin = reinterpret_cast<const std::byte*>(str);
+				const std::byte* end = begin + size;
+
+				append(begin, end);
+
+				return *this;
+			}
+
+			// write the value with its native width, whatever the format
+			template<typename T>
+			OutputByteStream& writeFixed(const T data)
+			{
+				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
+					"Fixed write only supports primitive data type");
+
+				const std::byte* begin = reinterpret_cast<const std::byte*>(std::addressof(data));
+				const std::byte* end = begin + sizeof(T);
+
+				append(begin, end);
+
+				return *this;
+			}
+
+			OutputByteStream& writeVarint(const std::uint64_t value)
+			{
+				std::byte data[Varint::max_size];
+				const std::size_t size = Varint::write(data, value);
+				append(data, data + size);
+				return *this;
+			}
+
+			// write a contiguous array of trivially copyable elements with a single copy
+			template<typename T>
+			OutputByteStream& writeArray(const T* const data, const std::size_t count)
+			{
+				static_assert(std::is_trivially_copyable<T>::value,
+					"Array write only supports trivially copyable data type");
+
+				if constexpr (Varint::supports<T>())
+				{
+					if (m_format.compact)
+					{
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							writeVarint(Varint::encode(data[i]));
+						}
+						return *this;
+					}
+				}
+
+				const std::byte* begin = reinterpret_cast<const std::byte*>(data);
+				const std::byte* end = begin + count * sizeof(T);
+
+				append(begin, end);
+
+				return *this;
+			}
+
+			// copy bytes already encoded in the format of the stream
+			OutputByteStream& writeBytes(const ByteBuffer& bytes)
+			{
+				append(bytes.data(), bytes.data() + bytes.size());
+				return *this;
+			}
+
+			// write a reflected value as a nested block
+			template<typename T>
+			OutputByteStream& writeBlock(const T& value)
+			{
+				// with references the size of a block depends on the objects already written
+				if (m_sink != nullptr && !m_format.references)
+				{
+					// flushed bytes can't be patched, the size is computed up front
+					if constexpr (std::is_base_of<IType, T>::value)
+					{
+						*this << value.binary_size(m_format);
+						value.to_bytes(*this);
+					}
+					else
+					{
+						*this << Type<T>::binary_size(value, m_format);
+						Type<T>::write(*this, value);
+					}
+					return *this;
+				}
+
+				const std::size_t position = beginBlock();
+				if constexpr (std::is_base_of<IType, T>::value)
+				{
+					value.to_bytes(*this);
+				}
+				else
+				{
+					Type<T>::write(*this, value);
+				}
+				endBlock(position);
+				return *this;
+			}
+
+			// write a shared object, or a reference to it if it was already written:
+			// 0 for null, 1 for an object that follows, the object index + 2 otherwise
+			template<typename T>
+			OutputByteStream& writeShared(const std::shared_ptr<T>& object)
+			{
+				if (!m_format.references)
+				{
+					*this << (object ? true : false);
+					return object ? writeBlock(*object) : *this;
+				}
+
+				if (!object) return *this << std::size_t{ 0 };
+
+				// the address of the most derived object, whatever pointer type owns it
+				const void* const address = dynamic_cast<const void*>(object.get());
+				const auto& it = m_references.find(address);
+				if (it != m_references.end())
+				{
+					return *this << (it->second + 2);
+				}
+
+				m_references.insert(std::make_pair(address, m_references.size()));
+				*this << std::size_t{ 1 };
+				return writeBlock(*object);
+			}
+
+			// forget the shared objects written so far, the next payload will write them again
+			void clearReferences()
+			{
+				m_references.clear();
+			}
+
+			// reserve the size prefix of a nested block and return its position
+			std::size_t beginBlock()
+			{
+				const std::size_t position = getPosition();
+				if (m_sink != nullptr)
+				{
+					// the bytes of an open block stay in the buffer until its size is patched
+					m_blocks.push_back(position);
+				}
+				if (m_format.compact)
+				{
+					m_buffer.push_back(std::byte{ 0 });
+				}
+				else
+				{
+					writeFixed(std::size_t{ 0 });
+				}
+				return position;
+			}
+
+			// patch the size prefix once the nested block has been written
+			void endBlock(const std::size_t position)
+			{
+				const std::size_t index = position - m_flushed;
+				if (m_format.compact)
+				{
+					// the varint prefix grows in place when the block needs more than one byte
+					const std::size_t size = m_buffer.size() - index - 1;
+					const std::size_t prefix = Varint::size(size);
+					if (prefix > 1)
+					{
+						m_buffer.insert(m_buffer.begin() + index + 1, prefix - 1, std::byte{ 0 });
+					}
+					Varint::write(&m_buffer[index], size);
+				}
+				else
+				{
+					const std::size_t size = m_buffer.size() - index - sizeof(std::size_t);
+					std::memcpy(&m_buffer[index], &size, sizeof(std::size_t));
+				}
+
+				if (m_sink != nullptr)
+				{
+					m_blocks.pop_back();
+				}
+			}
+
+			// in tagged format, write the header of a property and return its position
+			std::size_t beginField(const std::uint32_t tag)
+			{
+				if (!m_format.tagged) return getPosition();
+
+				writeFixed(tag);
+				return beginBlock();
+			}
+
+			void endField(const std::size_t position)
+			{
+				if (m_format.tagged)
+				{
+					endBlock(position);
+				}
+			}
+
+			// overwrite bytes already written, they must still be buffered: inside an open block when streaming
+			void patchBytes(const std::size_t position, const void* const data, const std::size_t size)
+			{
+				std::memcpy(&m_buffer[position - m_flushed], data, size);
+			}
+
+			// drop the bytes written from the given position on, they must still be buffered
+			void rewind(const std::size_t position)
+			{
+				m_buffer.resize(position - m_flushed);
+				while (!m_blocks.empty() && m_blocks.back() >= position)
+				{
+					m_blocks.pop_back();
+				}
+			}
+
+			// grow the buffer once for the given amount of bytes about to be written
+			void reserve(const std::size_t size)
+			{
+				if (m_sink != nullptr) return;
+
+				m_buffer.reserve(m_buffer.size() + size);
+			}
+
+			// write the buffered bytes to the sink, up to the first block still open
+			void flush()
+			{
+				if (m_sink == nullptr) return;
+
+				const std::size_t size = m_blocks.empty() ? m_buffer.size() : m_blocks.front() - m_flushed;
+				if (size == 0) return;
+
+				if (m_checksummed)
+				{
+					m_checksum = Crc32c::update(m_checksum, m_buffer.data(), size);
+				}
+				m_sink->write(reinterpret_cast<const char*>(m_buffer.data()), size);
+				m_buffer.erase(m_buffer.begin(), m_buffer.begin() + size);
+				m_flushed += size;
+			}
+
+			// number of bytes written since the stream was created
+			inline std::size_t getPosition() const { return m_flushed + m_buffer.size(); }
+
+			// compute the crc32c of the bytes flushed to the sink from now on,
+			// the bytes are final once flushed and still in cache
+			inline void enableChecksum() { m_checksummed = true; }
+			inline std::uint32_t getChecksum() const { return m_checksum; }
+
+			// number of bytes written by the matching operator<<
+
+			template<typename T>
+			static std::size_t sizeOf(const T data, const ByteFormat& format)
+			{
+				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
+					"Generic size only supports primitive data type");
+
+				if constexpr (Varint::supports<T>())
+				{
+					if (format.compact)
+					{
+						return Varint::size(Varint::encode(data));
+					}
+				}
+				return sizeof(T);
+			}
+
+			static std::size_t sizeOf(const std::string& data, const ByteFormat& format)
+			{
+				return sizeOf(data.size(), format) + data.size();
+			}
+
+			static std::size_t sizeOf(const char* str, const ByteFormat& format)
+			{
+				const std::size_t size = std::strlen(str);
+				return sizeOf(size, format) + size;
+			}
+
+			template<typename T>
+			static std::size_t sizeOfArray(const T* const data, const std::size_t count, const ByteFormat& format)
+			{
+				if constexpr (Varint::supports<T>())
+				{
+					if (format.compact)
+					{
+						std::size_t size = 0;
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							size += Varint::size(Varint::encode(data[i]));
+						}
+						return size;
+					}
+				}
+				return count * sizeof(T);
+			}
+
+			// number of bytes written by a nested block of the given size
+			static std::size_t sizeOfBlock(const std::size_t size, const ByteFormat& format)
+			{
+				return sizeOf(size, format) + size;
+			}
+
+			// number of bytes the field header adds to a property of the given size
+			static std::size_t sizeOfField(const std::size_t size, const ByteFormat& format)
+			{
+				return format.tagged ? sizeof(std::uint32_t) + sizeOf(size, format) : 0;
+			}
+
+			// number of bytes written by writeShared, an upper bound with references
+			// since repeated objects are written once
+			template<typename T>
+			static std::size_t sizeOfShared(const std::shared_ptr<T>& object, const ByteFormat& format)
+			{
+				if (!format.references)
+				{
+					return object ? sizeof(bool) + sizeOfBlock(object->binary_size(format), format) : sizeof(bool);
+				}
+
+				if (!object) return sizeOf(std::size_t{ 0 }, format);
+
+				// objects met again while sizing the outermost shared object are counted as references,
+				// that also stops the recursion on cycles
+				std::unordered_set<const void*>& visiting = sizingReferences();
+				if (!visiting.insert(dynamic_cast<const void*>(object.get())).second)
+				{
+					return format.compact ? Varint::max_size : sizeof(std::size_t);
+				}
+
+				const bool outermost = visiting.size() == 1;
+				const std::size_t size = sizeOf(std::size_t{ 1 }, format) + sizeOfBlock(object->binary_size(format), format);
+				if (outermost)
+				{
+					visiting.clear();
+				}
+				return size;
+			}
+
+		private:
+			static std::unordered_set<const void*>& sizingReferences()
+			{
+				thread_local std::unordered_set<const void*> s_references;
+				return s_references;
+			}
+
+			void append(const std::byte* const begin, const std::byte* const end)
+			{
+				m_buffer.insert(m_buffer.end(), begin, end);
+				if (m_sink != nullptr && m_buffer.size() >= m_chunk)
+				{
+					flush();
+				}
+			}
+
+			// destination of the flushed chunks, if any
+			std::ostream* m_sink{ nullptr };
+			std::size_t m_chunk{ chunk_size };
+			// bytes already written to the sink
+			std::size_t m_flushed{ 0 };
+			// crc32c of the flushed bytes, if enabled
+			bool m_checksummed{ false };
+			std::uint32_t m_checksum{ 0 };
+			// positions of the blocks waiting for their size
+			std::vector<std::size_t> m_blocks;
+			// indices of the shared objects already written
+			std::unordered_map<const void*, std::size_t> m_references;
+		};
+
+		// The Delta tells whether a property without operator== changed since the baseline, without encoding it,
+		// and copies the unchanged ones when a delta is applied.
+		// Reflected values probe their own delta on the stream, rewound right after,
+		// the pointers compare their identity and their dynamic type first.
+
+		struct Delta final
+		{
+			Delta() = delete;
+
+			// copy an unchanged property from the baseline, the objects that can't be copied keep their value
+			template<typename T>
+			static void assign(T& target, const T& baseline)
+			{
+				if constexpr (std::is_copy_assignable<T>::value)
+				{
+					target = baseline;
+				}
+				else
+				{
+					static_cast<void>(target);
+					static_cast<void>(baseline);
+				}
+			}
+
+			template<typename T>
+			static bool changed(const T& baseline, const T& current, OutputByteStream& stream)
+			{
+				if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value)
+				{
+					return !(baseline == current);
+				}
+				else
+				{
+					const std::size_t position = stream.getPosition();
+					const bool result = Type<T>::write_delta(baseline, current, stream);
+					stream.rewind(position);
+					return result;
+				}
+			}
+
+			template<typename T>
+			static bool changed(const std::shared_ptr<T>& baseline, const std::shared_ptr<T>& current, OutputByteStream& stream)
+			{
+				return changedObject(baseline.get(), current.get(), stream);
+			}
+
+			template<typename T>
+			static bool changed(const std::unique_ptr<T>& baseline, const std::unique_ptr<T>& current, OutputByteStream& stream)
+			{
+				return changedObject(baseline.get(), current.get(), stream);
+			}
+
+			template<typename T>
+			static bool changed(const std::vector<T>& baseline, const std::vector<T>& current, OutputByteStream& stream)
+			{
+				return changedRange(baseline, current, stream);
+			}
+
+			template<typename T>
+			static bool changed(const std::list<T>& baseline, const std::list<T>& current, OutputByteStream& stream)
+			{
+				return changedRange(baseline, current, stream);
+			}
+
+			template<typename K, typename V>
+			static bool changed(const std::map<K, V>& baseline, const std::map<K, V>& current, OutputByteStream& stream)
+			{
+				if (baseline.size() != current.size()) return true;
+
+				auto it = current.begin();
+				for (const auto& pair : baseline)
+				{
+					if (!(pair.first == it->first) || changed(pair.second, it->second, stream)) return true;
+					++it;
+				}
+				return false;
+			}
+
+			template<typename K, typename V>
+			static bool changed(const std::unordered_map<K, V>& baseline, const std::unordered_map<K, V>& current, OutputByteStream& stream)
+			{
+				if (baseline.size() != current.size()) return true;
+
+				for (const auto& pair : baseline)
+				{
+					const auto& it = current.find(pair.first);
+					if (it == current.end() || changed(pair.second, it->second, stream)) return true;
+				}
+				return false;
+			}
+
+		private:
+			template<typename T>
+			static bool changedObject(const T* const baseline, const T* const current, OutputByteStream& stream)
+			{
+				if (baseline == current) return false;
+				if (baseline == nullptr || current == nullptr) return true;
+
+				if constexpr (std::is_base_of<IType, T>::value)
+				{
+					if (baseline->type_id() != current->type_id()) return true;
+					if (current->type_id() != Type<T>::id())
+					{
+						// the delta of the pointer type misses the properties of a derived one
+						ByteBuffer before, after;
+						OutputByteStream beforeStream(before, stream.getFormat());
+						OutputByteStream afterStream(after, stream.getFormat());
+						baseline->to_bytes(beforeStream);
+						current->to_bytes(afterStream);
+						return before != after;
+					}
+				}
+				return changed(*baseline, *current, stream);
+			}
+
+			template<typename C>
+			static bool changedRange(const C& baseline, const C& current, OutputByteStream& stream)
+			{
+				if (baseline.size() != current.size()) return true;
+
+				auto it = current.begin();
+				for (const auto& element : baseline)
+				{
+					if (changed(element, *it, stream)) return true;
+					++it;
+				}
+				return false;
+			}
+		};
+
+		// The InputByteStream has methods for reading sequentially from a ByteView.
+		// Nested types are decoded in place, the stream never copies the bytes it reads.
+		// When a source is given, the buffer is a window refilled from the source chunk by chunk,
+		// indices are then relative to the beginning of the source.
+
+		class InputByteStream
+		{
+		public:
+			static constexpr std::size_t chunk_size = 64 * 1024;
+			// minimum number of elements worth decoding in parallel
+			static constexpr std::size_t parallel_threshold = 256;
+
+			InputByteStream(const ByteView& view, const ByteFormat& format = {})
+				: m_data{ view.data }
+				, m_size{ view.size }
+				, m_index{ 0 }
+				, m_format{ format }
+			{
+				assert(format.isValid() && "Tagged streams can't use references");
+			}
+
+			InputByteStream(const ByteView& view, const std::size_t index, const ByteFormat& format = {})
+				: m_data{ view.data }
+				, m_size{ view.size }
+				, m_index{ (std::min)(index, view.size) }
+				, m_format{ format }
+			{
+				assert(format.isValid() && "Tagged streams can't use references");
+			}
+
+			InputByteStream(ByteBuffer& buffer, std::istream& source, const ByteFormat& format = {}, const std::size_t chunk = chunk_size)
+				: m_data{ buffer.data() }
+				, m_size{ 0 }
+				, m_index{ 0 }
+				, m_format{ format }
+				, m_window{ &buffer }
+				, m_source{ &source }
+				, m_chunk{ chunk }
+			{
+				assert(format.isValid() && "Tagged streams can't use references");
+			}
+
+			template<typename T>
+			InputByteStream& operator>> (T& data)
+			{
+				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
+					"Generic read only supports primitive data type");
+
+				if constexpr (Varint::supports<T>())
+				{
+					if (m_format.compact)
+					{
+						data = Varint::decode<T>(readVarint());
+						return *this;
+					}
+				}
+
+				return readFixed(data);
+			}
+
+			InputByteStream& operator>> (std::string& data)
+			{
+				std::size_t characters{ 0 };
+				*this >> characters;
+
+				if (m_source != nullptr)
+				{
+					// the string may span several windows
+					data.clear();
+					while (characters > 0 && (m_index < m_size || refill(1)))
+					{
+						const std::size_t amount = (std::min<std::size_t>)(characters, getSize());
+						data.append(reinterpret_cast<const char*>(m_data + m_index), amount);
+						m_index += amount;
+						characters -= amount;
+					}
+					return *this;
+				}
+
+				const std::size_t amount = (std::min<std::size_t>)(characters, getSize());
+				if (amount > 0)
+				{
+					data.assign(reinterpret_cast<const char*>(m_data + m_index), amount);
+					m_index += amount;
+				}
+
+				return *this;
+			}
+
+			// read a value written with its native width, whatever the format
+			template<typename T>
+			InputByteStream& readFixed(T& data)
+			{
+				static_assert(std::is_fundamental<T>::value || std::is_enum<T>::value,
+					"Fixed read only supports primitive data type");
+
+				if (getSize() < sizeof(T))
+				{
+					refill(sizeof(T));
+				}
+
+				const std::size_t amount = (std::min<std::size_t>)(sizeof(T), getSize());
+				if (amount > 0)
+				{
+					std::memcpy(&data, m_data + m_index, amount);
+					m_index += amount;
+				}
+
+				return *this;
+			}
+
+			// read the next fixed width value without moving the reading index
+			template<typename T>
+			InputByteStream& peekFixed(T& data)
+			{
+				const std::size_t index = getIndex();
+				readFixed(data);
+				m_index = index - m_offset;
+				return *this;
+			}
+
+			std::uint64_t readVarint()
+			{
+				std::uint64_t value = 0;
+				for (unsigned int shift = 0; shift < 64 && (m_index < m_size || refill(1)); shift += 7)
+				{
+					const std::uint64_t data = static_cast<std::uint64_t>(m_data[m_index++]);
+					value |= (data & 0x7f) << shift;
+					if ((data & 0x80) == 0) break;
+				}
+				return value;
+			}
+
+			// read a contiguous array of trivially copyable elements with a single copy
+			template<typename T>
+			InputByteStream& readArray(T* const data, const std::size_t count)
+			{
+				static_assert(std::is_trivially_copyable<T>::value,
+					"Array read only supports trivially copyable data type");
+
+				if constexpr (Varint::supports<T>())
+				{
+					if (m_format.compact)
+					{
+						for (std::size_t i = 0; i < count; ++i)
+						{
+							data[i] = Varint::decode<T>(readVarint());
+						}
+						return *this;
+					}
+				}
+
+				// one copy per window when streaming
+				std::byte* destination = reinterpret_cast<std::byte*>(data);
+				std::size_t remaining = count * sizeof(T);
+				while (remaining > 0 && (m_index < m_size || refill(1)))
+				{
+					const std::size_t amount = (std::min<std::size_t>)(remaining, getSize());
+					std::memcpy(destination, m_data + m_index, amount);
+					m_index += amount;
+					destination += amount;
+					remaining -= amount;
+				}
+
+				return *this;
+			}
+
+			// whether a container of the given size should be decoded by readParallel
+			bool isParallel(const std::size_t count) const
+			{
+				// streamed windows move, memory resources are not thread safe and references need a single stream
+				return m_threads > 1 && count >= parallel_threshold && m_source == nullptr && m_resource == nullptr && !m_format.references;
+			}
+
+			// decode elements written as a presence flag followed by an optional nested block:
+			// the size prefixes are scanned to locate every element, then slices of elements
+			// are decoded concurrently, each by its own stream
+			template<typename Decode>
+			void readParallel(const std::size_t count, Decode&& decode)
+			{
+				std::vector<std::size_t> offsets(count);
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					offsets[i] = m_index;
+					bool valid = false;
+					*this >> valid;
+					if (valid)
+					{
+						endBlock(beginBlock());
+					}
+				}
+
+				const std::size_t threads = (std::min<std::size_t>)(m_threads, count);
+				const std::size_t slice = threads > 0 ? (count + threads - 1) / threads : 0;
+				std::vector<std::future<void>> workers;
+				for (std::size_t begin = 0; begin < count; begin += slice)
+				{
+					const std::size_t end = (std::min)(begin + slice, count);
+					workers.push_back(std::async(std::launch::async, [this, &offsets, &decode, begin, end]()
+						{
+							for (std::size_t i = begin; i < end; ++i)
+							{
+								InputByteStream stream(ByteView(m_data, m_size), offsets[i], m_format);
+								decode(stream, i);
+							}
+						}));
+				}
+				// wait for every slice before rethrowing the first failure
+				for (std::future<void>& worker : workers)
+				{
+					worker.wait();
+				}
+				for (std::future<void>& worker : workers)
+				{
+					worker.get();
+				}
+			}
+
+			// read the header written by writeShared, return true if the object follows,
+			// otherwise the pointer is set to null or to the object decoded earlier
+			template<typename T>
+			bool readShared(std::shared_ptr<T>& object)
+			{
+				if (!m_format.references)
+				{
+					bool valid = false;
+					*this >> valid;
+					if (!valid) object = nullptr;
+					return valid;
+				}
+
+				std::size_t reference{ 0 };
+				*this >> reference;
+				if (reference == 1) return true;
+
+				object = reference >= 2 && reference - 2 < m_shared.size() ? std::dynamic_pointer_cast<T>(m_shared[reference - 2]) : nullptr;
+				return false;
+			}
+
+			// register a shared object before decoding it, so that it can refer to itself
+			template<typename T>
+			void addShared(const std::shared_ptr<T>& object)
+			{
+				if (m_format.references)
+				{
+					m_shared.push_back(object);
+				}
+			}
+
+			// allocate a decoded shared object from the stream's memory resource, the default heap if none
+			template<typename T>
+			std::shared_ptr<T> makeShared() const
+			{
+				if (m_resource == nullptr) return std::make_shared<T>();
+
+				return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(m_resource));
+			}
+
+			// the largest element count, up to the given one, the remaining bytes can hold
+			template<typename T>
+			std::size_t clampArray(const std::size_t count) const
+			{
+				// the size of a streamed source is unknown
+				if (m_source != nullptr) return count;
+
+				const std::size_t element_size = Varint::supports<T>() && m_format.compact ? 1 : sizeof(T);
+				return (std::min<std::size_t>)(count, getSize() / element_size);
+			}
+
+			// read the size prefix of a nested block and return the index where the block ends
+			std::size_t beginBlock()
+			{
+				std::size_t size{ 0 };
+				*this >> size;
+				if (m_source != nullptr) return getIndex() + size;
+
+				return m_index + (std::min<std::size_t>)(size, getSize());
+			}
+
+			// move to the end of a nested block, whatever the decoder consumed of it
+			void endBlock(const std::size_t end)
+			{
+				const std::size_t index = getIndex();
+				if (end >= index)
+				{
+					skip(end - index);
+				}
+				else if (end >= m_offset)
+				{
+					m_index = end - m_offset;
+				}
+			}
+
+			// in tagged format, read the header of a property and return the index where it ends
+			std::size_t beginField()
+			{
+				std::uint32_t tag{ 0 };
+				return beginField(tag);
+			}
+
+			std::size_t beginField(std::uint32_t& tag)
+			{
+				if (!m_format.tagged) return m_offset + m_size;
+
+				readFixed(tag);
+				return beginBlock();
+			}
+
+			void endField(const std::size_t end)
+			{
+				if (m_format.tagged)
+				{
+					endBlock(end);
+				}
+			}
+
+			void skip(std::size_t amount)
+			{
+				while (amount > 0 && (m_index < m_size || refill(1)))
+				{
+					const std::size_t step = (std::min<std::size_t>)(amount, getSize());
+					m_index += step;
+					amount -= step;
+				}
+			}
+
+			inline const std::byte* getNativeBuffer() const { return m_data; }
+			inline const ByteFormat& getFormat() const { return m_format; }
+			inline std::size_t getIndex() const { return m_offset + m_index; }
+			inline std::pmr::memory_resource* getResource() const { return m_resource; }
+			inline void setResource(std::pmr::memory_resource* const resource) { m_resource = resource; }
+			inline std::size_t getThreads() const { return m_threads; }
+			// number of threads decoding large containers of pointers, 1 to decode sequentially
+			inline void setThreads(const std::size_t threads) { m_threads = threads; }
+			// number of bytes available without reading from the source
+			inline std::size_t getSize() const { return m_size - m_index; }
+
+		private:
+			// keep the unread bytes, read at least the given amount of new ones if the source has them
+			bool refill(const std::size_t amount)
+			{
+				if (m_source == nullptr) return false;
+
+				ByteBuffer& window = *m_window;
+				const std::size_t unread = getSize();
+				if (unread > 0)
+				{
+					std::memmove(window.data(), m_data + m_index, unread);
+				}
+				m_offset += m_index;
+
+				const std::size_t capacity = (std::max<std::size_t>)(m_chunk, unread + amount);
+				if (window.size() < capacity)
+				{
+					window.resize(capacity);
+				}
+
+				m_source->read(reinterpret_cast<char*>(window.data() + unread), window.size() - unread);
+				const std::size_t count = static_cast<std::size_t>(m_source->gcount());
+
+				m_data = window.data();
+				m_size = unread + count;
+				m_index = 0;
+				return count > 0;
+			}
+
+			// bytes to read from, not owned by the stream
+			const std::byte* m_data;
+			std::size_t m_size;
+			// reading byte index
+			std::size_t m_index;
+			// wire format
+			ByteFormat m_format;
+			// window and source of a streamed read, if any
+			ByteBuffer* m_window{ nullptr };
+			std::istream* m_source{ nullptr };
+			std::size_t m_chunk{ chunk_size };
+			// bytes of the source before the window
+			std::size_t m_offset{ 0 };
+			// memory resource of the decoded shared objects, not owned by the stream
+			std::pmr::memory_resource* m_resource{ nullptr };
+			std::size_t m_threads{ 1 };
+			// shared objects decoded so far, by reference index
+			std::vector<std::shared_ptr<IType>> m_shared;
+		};
+
+		// The archive is a sequence of independent object payloads followed by a table of contents,
+		// every object can be located and decoded without reading the others.
+		// layout: header | payloads | entry count, entries | table offset, magic
+
+		struct ArchiveEntry
+		{
+			type_id_t type_id{ 0 };
+			// position and size of the payload in the archive
+			std::size_t offset{ 0 };
+			std::size_t length{ 0 };
+			// optional name of the object, unique in the archive
+			std::string key;
+		};
+
+		struct Archive final
+		{
+			Archive() = delete;
+			~Archive() = delete;
+
+			static constexpr std::uint32_t magic = 0x41544456; // VDTA
+			static constexpr std::uint32_t version = 1;
+			// magic, version, format flags
+			static constexpr std::size_t header_size = sizeof(std::uint32_t) + sizeof(std::uint32_t) + sizeof(std::uint8_t);
+			// table offset, magic
+			static constexpr std::size_t footer_size = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+			// with a checksum the footer holds the crc32c of all the bytes before it, before the magic
+			static constexpr std::size_t checksum_size = sizeof(std::uint32_t);
+
+			// format flags
+			static constexpr std::uint8_t flag_compact = 1;
+			static constexpr std::uint8_t flag_tagged = 2;
+			static constexpr std::uint8_t flag_references = 4;
+			static constexpr std::uint8_t flag_checksum = 8;
+		};
+
+		// The ArchiveWriter streams the objects to the sink as they are added,
+		// the table of contents is written on close.
+
+		class ArchiveWriter
+		{
+		public:
+			ArchiveWriter(std::ostream& sink, const ByteFormat& format = {}, const bool checksum = false)
+				: m_stream{ m_buffer, sink, format }
+				, m_checksum{ checksum }
+			{
+				if (m_checksum)
+				{
+					m_stream.enableChecksum();
+				}
+				m_stream.writeFixed(Archive::magic);
+				m_stream.writeFixed(Archive::version);
+				m_stream.writeFixed(static_cast<std::uint8_t>((format.compact ? Archive::flag_compact : 0)
+					| (format.tagged ? Archive::flag_tagged : 0)
+					| (format.references ? Archive::flag_references : 0)
+					| (checksum ? Archive::flag_checksum : 0)));
+			}
+
+			ArchiveWriter(const ArchiveWriter&) = delete;
+			ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+			~ArchiveWriter()
+			{
+				close();
+			}
+
+			template<typename T>
+			void add(const T& object, const std::string& key = "")
+			{
+				// every payload is decoded on its own
+				m_stream.clearReferences();
+				const std::size_t offset = m_stream.getPosition();
+				if constexpr (std::is_base_of<IType, T>::value)
+				{
+					object.to_bytes(m_stream);
+					m_entries.push_back({ object.type_id(), offset, m_stream.getPosition() - offset, key });
+				}
+				else
+				{
+					Type<T>::write(m_stream, object);
+					m_entries.push_back({ Type<T>::id(), offset, m_stream.getPosition() - offset, key });
+				}
+			}
+
+			// write the table of contents, no object can be added afterwards
+			void close()
+			{
+				if (m_closed) return;
+
+				const std::uint64_t table = m_stream.getPosition();
+				m_stream << m_entries.size();
+				for (const ArchiveEntry& entry : m_entries)
+				{
+					m_stream.writeFixed(entry.type_id);
+					m_stream << entry.offset;
+					m_stream << entry.length;
+					m_stream << entry.key;
+				}
+				m_stream.writeFixed(table);
+				if (m_checksum)
+				{
+					m_stream.flush();
+					m_stream.writeFixed(m_stream.getChecksum());
+				}
+				m_stream.writeFixed(Archive::magic);
+				m_stream.flush();
+				m_closed = true;
+			}
+
+			inline std::size_t size() const { return m_entries.size(); }
+
+		private:
+			ByteBuffer m_buffer;
+			OutputByteStream m_stream;
+			std::vector<ArchiveEntry> m_entries;
+			bool m_checksum{ false };
+			bool m_closed{ false };
+		};
+
+		// The ArchiveReader parses the table of contents of an archive in memory, usually a MappedByteBuffer,
+		// the bytes are not owned and must outlive the reader.
+
+		class ArchiveReader
+		{
+		public:
+			static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+			// an archive with a checksum is verified unless told otherwise,
+			// which reads all of its bytes once
+			ArchiveReader(const ByteView& view, const bool verify = true)
+				: m_data{ view.data }
+				, m_size{ view.size }
+			{
+				if (m_size < Archive::header_size + Archive::footer_size) return;
+
+				InputByteStream header(view);
+				std::uint32_t magic{ 0 }, version{ 0 };
+				std::uint8_t flags{ 0 };
+				header.readFixed(magic).readFixed(version).readFixed(flags);
+				if (magic != Archive::magic || version != Archive::version) return;
+
+				m_format.compact = (flags & Archive::flag_compact) != 0;
+				m_format.tagged = (flags & Archive::flag_tagged) != 0;
+				m_format.references = (flags & Archive::flag_references) != 0;
+				m_checksummed = (flags & Archive::flag_checksum) != 0;
+				if (!m_format.isValid()) return;
+
+				const std::size_t footer_size = Archive::footer_size + (m_checksummed ? Archive::checksum_size : 0);
+				if (m_size < Archive::header_size + footer_size) return;
+
+				InputByteStream footer(view, m_size - footer_size);
+				std::uint64_t table{ 0 };
+				std::uint32_t checksum{ 0 };
+				footer.readFixed(table);
+				if (m_checksummed)
+				{
+					footer.readFixed(checksum);
+				}
+				footer.readFixed(magic);
+				if (magic != Archive::magic || table < Archive::header_size || table > m_size - footer_size) return;
+
+				if (m_checksummed && verify)
+				{
+					const std::size_t checked = m_size - Archive::checksum_size - sizeof(std::uint32_t);
+					if (Crc32c::compute(ByteView(m_data, checked)) != checksum) return;
+				}
+
+				InputByteStream stream(ByteView(m_data, m_size - footer_size), static_cast<std::size_t>(table), m_format);
+				std::size_t count{ 0 };
+				stream >> count;
+				for (std::size_t i = 0; i < count && stream.getSize() > 0; ++i)
+				{
+					ArchiveEntry entry;
+					stream.readFixed(entry.type_id);
+					stream >> entry.offset;
+					stream >> entry.length;
+					stream >> entry.key;
+					// payloads can't overlap the table
+					if (entry.offset < Archive::header_size || entry.offset > table || entry.length > table - entry.offset) return;
+
+					if (!entry.key.empty())
+					{
+						m_keys.insert(std::make_pair(entry.key, m_entries.size()));
+					}
+					m_entries.push_back(std::move(entry));
+				}
+				m_valid = m_entries.size() == count;
+			}
+
+			inline bool isValid() const { return m_valid; }
+			inline bool hasChecksum() const { return m_checksummed; }
+			inline const ByteFormat& getFormat() const { return m_format; }
+			inline std::size_t size() const { return m_entries.size(); }
+			inline const std::vector<ArchiveEntry>& entries() const { return m_entries; }
+			inline const ArchiveEntry& entry(const std::size_t index) const { return m_entries[index]; }
+
+			// index of the entry with the given key, npos if missing
+			std::size_t find(const std::string& key) const
+			{
+				const auto& it = m_keys.find(key);
+				return it != m_keys.end() ? it->second : npos;
+			}
+
+			// bytes of a single payload
+			ByteView view(const std::size_t index) const
+			{
+				const ArchiveEntry& entry = m_entries[index];
+				return ByteView(m_data + entry.offset, entry.length);
+			}
+
+			// decode a single object, the entry must hold exactly the type T
+			template<typename T>
+			bool read(const std::size_t index, T& object) const
+			{
+				if (index >= m_entries.size() || m_entries[index].type_id != Type<T>::id()) return false;
+
+				InputByteStream stream(view(index), m_format);
+				Type<T>::read(stream, object);
+				return true;
+			}
+
+			template<typename T>
+			bool read(const std::string& key, T& object) const
+			{
+				return read(find(key), object);
+			}
+
+			// create and decode a single object of any registered type
+			std::unique_ptr<IType> instantiate(const std::size_t index) const
+			{
+				if (index >= m_entries.size()) return nullptr;
+
+				std::unique_ptr<IType> object(TypeFactory::instantiate(m_entries[index].type_id));
+				if (object)
+				{
+					InputByteStream stream(view(index), m_format);
+					object->from_bytes(stream);
+				}
+				return object;
+			}
+
+			std::unique_ptr<IType> instantiate(const std::string& key) const
+			{
+				return instantiate(find(key));
+			}
+
+		private:
+			// archive bytes, not owned by the reader
+			const std::byte* m_data;
+			std::size_t m_size;
+			ByteFormat m_format;
+			std::vector<ArchiveEntry> m_entries;
+			std::unordered_map<std::string, std::size_t> m_keys;
+			bool m_checksummed{ false };
+			bool m_valid{ false };
+		};
+
+		// The FieldIndex locates the properties of a payload in tagged format without decoding them.
+
+		class FieldIndex
+		{
+		public:
+			struct Field
+			{
+				std::uint32_t tag{ 0 };
+				// bytes of the property value
+				std::size_t begin{ 0 };
+				std::size_t end{ 0 };
+			};
+
+			FieldIndex(const ByteView& view, const ByteFormat& format)
+				: m_view{ view }
+				, m_format{ format }
+			{
+				// fields are decoded one by one, references to other fields can't be resolved
+				if (!format.tagged || format.references || view.size < sizeof(type_id_t) + sizeof(std::uint64_t)) return;
+
+				InputByteStream stream(view, format);
+				std::uint64_t schema{ 0 };
+				std::size_t count{ 0 };
+				stream.readFixed(m_type_id).readFixed(schema);
+				stream >> count;
+				for (std::size_t i = 0; i < count && stream.getSize() > 0; ++i)
+				{
+					Field field;
+					field.end = stream.beginField(field.tag);
+					field.begin = stream.getIndex();
+					m_fields.push_back(field);
+					stream.endField(field.end);
+				}
+				m_valid = m_fields.size() == count;
+			}
+
+			// the tag the compiler gives to the property with the given name
+			static std::uint32_t tag(const std::string& name)
+			{
+				std::uint64_t hash = 14695981039346656037ull;
+				for (const char c : name)
+				{
+					hash ^= static_cast<unsigned char>(c);
+					hash *= 1099511628211ull;
+				}
+				return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+			}
+
+			const Field* find(const std::uint32_t tag) const
+			{
+				for (const Field& field : m_fields)
+				{
+					if (field.tag == tag) return &field;
+				}
+				return nullptr;
+			}
+
+			// a stream over the value of a single property
+			InputByteStream stream(const Field& field) const
+			{
+				return InputByteStream(ByteView(m_view.data, field.end), field.begin, m_format);
+			}
+
+			inline bool isValid() const { return m_valid; }
+			inline type_id_t getTypeId() const { return m_type_id; }
+			inline const std::vector<Field>& fields() const { return m_fields; }
+
+		private:
+			ByteView m_view;
+			ByteFormat m_format;
+			type_id_t m_type_id{ 0 };
+			std::vector<Field> m_fields;
+			bool m_valid{ false };
+		};
+
+		// The LazyView decodes the properties of a payload in tagged format on first access,
+		// decoded values are kept in a default constructed object. The bytes must outlive the view.
+
+		template<typename T>
+		class LazyView
+		{
+		public:
+			LazyView(const ByteView& view, const ByteFormat& format)
+				: m_fields{ view, format }
+			{}
+
+			inline bool isValid() const { return m_fields.isValid() && m_fields.getTypeId() == Type<T>::id(); }
+
+			template<typename M, typename C>
+			const M& get(M C::* const member)
+			{
+				static_assert(std::is_base_of<C, T>::value, "The member doesn't belong to the viewed type");
+
+				const M& value = m_object.*member;
+				fetch(reinterpret_cast<member_address_t>(std::addressof(value)) - reinterpret_cast<member_address_t>(std::addressof(m_object)));
+				return value;
+			}
+
+			// decode the property with the given name, if not yet decoded
+			void fetch(const std::string& name)
+			{
+				const auto& it = Type<T>::properties().find(name);
+				if (it != Type<T>::properties().end())
+				{
+					fetch(it->second.offset);
+				}
+			}
+
+			// the object with the properties decoded so far
+			inline const T& object() const { return m_object; }
+
+		private:
+			void fetch(const std::size_t offset)
+			{
+				if (std::find(m_decoded.begin(), m_decoded.end(), offset) != m_decoded.end()) return;
+				m_decoded.push_back(offset);
+
+				if (!isValid()) return;
+
+				for (const auto& [name, property] : Type<T>::properties())
+				{
+					if (property.offset != offset) continue;
+
+					const std::uint32_t tag = FieldIndex::tag(name);
+					if (const FieldIndex::Field* const field = m_fields.find(tag))
+					{
+						InputByteStream stream = m_fields.stream(*field);
+						Type<T>::read_field(stream, m_object, tag);
+					}
+					return;
+				}
+			}
+
+			FieldIndex m_fields;
+			T m_object;
+			// offsets of the properties already decoded
+			std::vector<std::size_t> m_decoded;
+		};
+
+		// The flat format is read in place, without decoding: every object is a table of slots
+		// holding the absolute offsets of its properties, 0 for the missing ones.
+		// Scalars are aligned to their size, strings and arrays are prefixed by their length.
+		// layout: root table offset | tables and values
+		// table: slot count, slots | string: length, characters, '\0' | array: count, elements
+
+		class FlatBuilder
+		{
+		public:
+			FlatBuilder(ByteBuffer& buffer)
+				: m_buffer{ buffer }
+			{
+				m_buffer.clear();
+				write(std::uint32_t{ 0 });
+			}
+
+			// write an empty table and return its offset
+			std::size_t beginTable(const std::uint32_t slots)
+			{
+				align(sizeof(std::uint32_t));
+				const std::size_t table = m_buffer.size();
+				write(slots);
+				m_buffer.resize(m_buffer.size() + slots * sizeof(std::uint32_t));
+				return table;
+			}
+
+			void setSlot(const std::size_t table, const std::uint32_t slot, const std::size_t offset)
+			{
+				const std::uint32_t value = narrow(offset);
+				std::memcpy(&m_buffer[table + sizeof(std::uint32_t) * (1 + slot)], &value, sizeof(std::uint32_t));
+			}
+
+			template<typename T>
+			void addScalar(const std::size_t table, const std::uint32_t slot, const T value)
+			{
+				static_assert(std::is_fundamental<T>::value, "Flat scalars only support primitive data type");
+
+				align(alignof(T));
+				setSlot(table, slot, m_buffer.size());
+				write(value);
+			}
+
+			void addString(const std::size_t table, const std::uint32_t slot, const std::string& value)
+			{
+				align(sizeof(std::uint32_t));
+				setSlot(table, slot, m_buffer.size());
+				write(narrow(value.size()));
+				const std::byte* const begin = reinterpret_cast<const std::byte*>(value.data());
+				m_buffer.insert(m_buffer.end(), begin, begin + value.size());
+				m_buffer.push_back(std::byte{ 0 });
+			}
+
+			template<typename T>
+			void addArray(const std::size_t table, const std::uint32_t slot, const T* const data, const std::size_t count)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "Flat arrays only support trivially copyable data type");
+
+				// the elements follow the count, aligned to their size
+				alignArray(alignof(T));
+				setSlot(table, slot, m_buffer.size());
+				write(narrow(count));
+				const std::byte* const begin = reinterpret_cast<const std::byte*>(data);
+				m_buffer.insert(m_buffer.end(), begin, begin + count * sizeof(T));
+			}
+
+			// write an array of table offsets, to be set once the tables are written
+			std::size_t beginTableArray(const std::size_t table, const std::uint32_t slot, const std::size_t count)
+			{
+				align(sizeof(std::uint32_t));
+				const std::size_t array = m_buffer.size();
+				setSlot(table, slot, array);
+				write(narrow(count));
+				m_buffer.resize(m_buffer.size() + count * sizeof(std::uint32_t));
+				return array;
+			}
+
+			void setElement(const std::size_t array, const std::size_t index, const std::size_t offset)
+			{
+				const std::uint32_t value = narrow(offset);
+				std::memcpy(&m_buffer[array + sizeof(std::uint32_t) * (1 + index)], &value, sizeof(std::uint32_t));
+			}
+
+			// point the root of the buffer at the given table,
+			// a buffer with offsets or lengths past 32 bits is cleared as it can't be read back
+			void finish(const std::size_t root)
+			{
+				const std::uint32_t value = narrow(root);
+				if (m_overflow)
+				{
+					m_buffer.clear();
+					return;
+				}
+				std::memcpy(&m_buffer[0], &value, sizeof(std::uint32_t));
+			}
+
+		private:
+			std::uint32_t narrow(const std::size_t value)
+			{
+				const bool fits = value <= (std::numeric_limits<std::uint32_t>::max)();
+				assert(fits && "Flat buffers are limited to 32 bits offsets");
+				m_overflow = m_overflow || !fits;
+				return static_cast<std::uint32_t>(value);
+			}
+
+			template<typename T>
+			void write(const T value)
+			{
+				const std::byte* const begin = reinterpret_cast<const std::byte*>(std::addressof(value));
+				m_buffer.insert(m_buffer.end(), begin, begin + sizeof(T));
+			}
+
+			void align(const std::size_t alignment)
+			{
+				m_buffer.resize((m_buffer.size() + alignment - 1) / alignment * alignment);
+			}
+
+			void alignArray(const std::size_t alignment)
+			{
+				align(sizeof(std::uint32_t));
+				while ((m_buffer.size() + sizeof(std::uint32_t)) % alignment != 0)
+				{
+					m_buffer.resize(m_buffer.size() + sizeof(std::uint32_t));
+				}
+			}
+
+			ByteBuffer& m_buffer;
+			bool m_overflow{ false };
+		};
+
+		template<typename T>
+		class FlatArray;
+
+		// The FlatTable reads the properties of an object in a flat buffer,
+		// every access is bounds checked and missing properties read as default values.
+
+		class FlatTable
+		{
+		public:
+			FlatTable() = default;
+
+			// the root table of a flat buffer
+			FlatTable(const ByteView& view)
+				: m_data{ view.data }
+				, m_size{ view.size }
+			{
+				m_table = read<std::uint32_t>(0);
+				m_slots = read<std::uint32_t>(m_table);
+				if (m_table == 0 || m_table + sizeof(std::uint32_t) * (1 + std::size_t{ m_slots }) > m_size)
+				{
+					m_slots = 0;
+				}
+			}
+
+			FlatTable(const std::byte* const data, const std::size_t size, const std::size_t table)
+				: m_data{ data }
+				, m_size{ size }
+				, m_table{ table }
+			{
+				m_slots = read<std::uint32_t>(m_table);
+				if (m_table == 0 || m_table + sizeof(std::uint32_t) * (1 + std::size_t{ m_slots }) > m_size)
+				{
+					m_slots = 0;
+				}
+			}
+
+			inline bool isValid() const { return m_slots > 0; }
+
+			bool has(const std::uint32_t slot) const
+			{
+				return position(slot) != 0;
+			}
+
+			template<typename T>
+			T scalar(const std::uint32_t slot, const T fallback = T{}) const
+			{
+				const std::size_t offset = position(slot);
+				return offset != 0 ? read<T>(offset, fallback) : fallback;
+			}
+
+			std::string_view string(const std::uint32_t slot) const
+			{
+				const std::size_t offset = position(slot);
+				const std::size_t length = read<std::uint32_t>(offset);
+				if (offset == 0 || offset + sizeof(std::uint32_t) + length > m_size) return {};
+
+				return std::string_view(reinterpret_cast<const char*>(m_data + offset + sizeof(std::uint32_t)), length);
+			}
+
+			FlatTable table(const std::uint32_t slot) const
+			{
+				const std::size_t offset = position(slot);
+				return offset != 0 ? FlatTable(m_data, m_size, offset) : FlatTable();
+			}
+
+			template<typename T>
+			FlatArray<T> array(const std::uint32_t slot) const
+			{
+				const std::size_t offset = position(slot);
+				if (offset == 0 || offset + sizeof(std::uint32_t) > m_size) return {};
+
+				const std::size_t count = read<std::uint32_t>(offset);
+				const std::size_t stride = std::is_same<T, FlatTable>::value ? sizeof(std::uint32_t) : sizeof(T);
+				if (count > (m_size - offset - sizeof(std::uint32_t)) / stride) return {};
+
+				return FlatArray<T>(m_data, m_size, offset + sizeof(std::uint32_t), count);
+			}
+
+		private:
+			std::size_t position(const std::uint32_t slot) const
+			{
+				if (slot >= m_slots) return 0;
+
+				const std::size_t offset = read<std::uint32_t>(m_table + sizeof(std::uint32_t) * (1 + std::size_t{ slot }));
+				return offset < m_size ? offset : 0;
+			}
+
+			template<typename T>
+			T read(const std::size_t offset, const T fallback = T{}) const
+			{
+				if (offset + sizeof(T) > m_size) return fallback;
+
+				T value;
+				std::memcpy(&value, m_data + offset, sizeof(T));
+				return value;
+			}
+
+			// buffer, not owned by the table
+			const std::byte* m_data{ nullptr };
+			std::size_t m_size{ 0 };
+			std::size_t m_table{ 0 };
+			std::uint32_t m_slots{ 0 };
+		};
+
+		template<typename T>
+		class FlatArray
+		{
+		public:
+			FlatArray() = default;
+
+			FlatArray(const std::byte* const data, const std::size_t size, const std::size_t elements, const std::size_t count)
+				: m_data{ data }
+				, m_size{ size }
+				, m_elements{ elements }
+				, m_count{ count }
+			{}
+
+			inline std::size_t size() const { return m_count; }
+			inline bool empty() const { return m_count == 0; }
+
+			// out of range elements read as default values
+			T operator[](const std::size_t index) const
+			{
+				if (index >= m_count) return T{};
+
+				if constexpr (std::is_same<T, FlatTable>::value)
+				{
+					std::uint32_t offset;
+					std::memcpy(&offset, m_data + m_elements + index * sizeof(std::uint32_t), sizeof(std::uint32_t));
+					return FlatTable(m_data, m_size, offset);
+				}
+				else
+				{
+					T value;
+					std::memcpy(&value, m_data + m_elements + index * sizeof(T), sizeof(T));
+					return value;
+				}
+			}
+
+			// the elements in place, aligned if the buffer is
+			const T* data() const
+			{
+				static_assert(!std::is_same<T, FlatTable>::value, "Arrays of tables hold offsets");
+				return reinterpret_cast<const T*>(m_data + m_elements);
+			}
+
+		private:
+			const std::byte* m_data{ nullptr };
+			std::size_t m_size{ 0 };
+			std::size_t m_elements{ 0 };
+			std::size_t m_count{ 0 };
+		};
+
+		namespace json
+		{
+			// The StructuralIndex lists the positions of the quotes and of the brackets, colons and commas
+			// outside of the strings of a json text, classifying 64 bytes at a time.
+			// The blocks are compared with AVX2 when the CPU has it, checked once at run time, SSE2 on x86-64,
+			// and byte by byte otherwise. The escaped quotes are found from the runs of backslashes,
+			// then a prefix xor of the quotes masks the characters inside the strings.
+			// Building again into the same index reuses the memory of the positions.
+
+			class StructuralIndex
+			{
+			public:
+				StructuralIndex() = default;
+
+				explicit StructuralIndex(const std::string_view text)
+				{
+					build(text);
+				}
+
+				void build(const std::string_view text)
+				{
+					m_positions.clear();
+					m_size = text.size();
+					m_valid = text.size() <= (std::numeric_limits<std::uint32_t>::max)();
+					if (!m_valid) return;
+
+					m_positions.reserve(text.size() / 8);
+
+					std::uint64_t escape_carry = 0;
+					std::uint64_t string_carry = 0;
+					std::size_t offset = 0;
+					for (; offset + block_size <= text.size(); offset += block_size)
+					{
+						indexBlock(text.data() + offset, offset, escape_carry, string_carry);
+					}
+					if (offset < text.size())
+					{
+						char block[block_size];
+						std::memset(block, ' ', block_size);
+						std::memcpy(block, text.data() + offset, text.size() - offset);
+						indexBlock(block, offset, escape_carry, string_carry);
+					}
+
+					// an unterminated string leaves the brackets after it unindexed
+					m_valid = string_carry == 0;
+				}
+
+				inline const std::vector<std::uint32_t>& getPositions() const { return m_positions; }
+				// size of the indexed text
+				inline std::size_t getSize() const { return m_size; }
+				inline bool isValid() const { return m_valid; }
+
+				static constexpr std::size_t block_size = 64;
+
+			private:
+				struct Masks
+				{
+					std::uint64_t backslash{ 0 };
+					std::uint64_t quote{ 0 };
+					std::uint64_t structural{ 0 };
+				};
+
+				void indexBlock(const char* const block, const std::size_t offset, std::uint64_t& escape_carry, std::uint64_t& string_carry)
+				{
+					const Masks masks = classify(block);
+
+					// a backslash escapes the next character, unless it is escaped itself
+					std::uint64_t escaped = escape_carry;
+					escape_carry = 0;
+					std::uint64_t backslash = masks.backslash & ~escaped;
+					while (backslash != 0)
+					{
+						const unsigned int bit = trailingZeros(backslash);
+						if (bit == 63)
+						{
+							escape_carry = 1;
+						}
+						else
+						{
+							escaped |= std::uint64_t{ 1 } << (bit + 1);
+							backslash &= ~(std::uint64_t{ 1 } << (bit + 1));
+						}
+						backslash &= backslash - 1;
+					}
+
+					const std::uint64_t quote = masks.quote & ~escaped;
+					const std::uint64_t inside = prefixXor(quote) ^ string_carry;
+					string_carry = (inside >> 63) != 0 ? ~std::uint64_t{ 0 } : 0;
+
+					std::uint64_t structural = (masks.structural & ~inside) | quote;
+					while (structural != 0)
+					{
+						m_positions.push_back(static_cast<std::uint32_t>(offset + trailingZeros(structural)));
+						structural &= structural - 1;
+					}
+				}
+
+				static Masks classify(const char* const block)
+				{
+#if defined(VDTREFLECT_JSON_AVX2_DISPATCH)
+					static const bool s_avx2 = __builtin_cpu_supports("avx2");
+					if (s_avx2)
+					{
+						return classifyAvx2(block);
+					}
+					return classifySse2(block);
+#elif defined(VDTREFLECT_JSON_AVX2)
+					return classifyAvx2(block);
+#elif defined(VDTREFLECT_JSON_SSE2)
+					return classifySse2(block);
+#else
+					Masks masks;
+					for (std::size_t i = 0; i < block_size; ++i)
+					{
+						const char c = block[i];
+						const std::uint64_t bit = std::uint64_t{ 1 } << i;
+						if (c == '\\') masks.backslash |= bit;
+						else if (c == '"') masks.quote |= bit;
+						else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') masks.structural |= bit;
+					}
+					return masks;
+#endif
+				}
+
+#if defined(VDTREFLECT_JSON_SSE2)
+				static Masks classifySse2(const char* const block)
+				{
+					// the brackets differ from the braces by the 0x20 bit
+					const __m128i backslash = _mm_set1_epi8('\\');
+					const __m128i quote = _mm_set1_epi8('"');
+					const __m128i case_bit = _mm_set1_epi8(0x20);
+					const __m128i open = _mm_set1_epi8('{');
+					const __m128i close = _mm_set1_epi8('}');
+					const __m128i colon = _mm_set1_epi8(':');
+					const __m128i comma = _mm_set1_epi8(',');
+
+					Masks masks;
+					for (std::size_t i = 0; i < block_size; i += 16)
+					{
+						const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+						const __m128i folded = _mm_or_si128(data, case_bit);
+						const __m128i structural = _mm_or_si128(
+							_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+							_mm_or_si128(_mm_cmpeq_epi8(data, colon), _mm_cmpeq_epi8(data, comma)));
+
+						masks.backslash |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, backslash)))) << i;
+						masks.quote |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote)))) << i;
+						masks.structural |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(structural))) << i;
+					}
+					return masks;
+				}
+#endif
+
+#if defined(VDTREFLECT_JSON_AVX2)
+				VDTREFLECT_TARGET_AVX2 static Masks classifyAvx2(const char* const block)
+				{
+					const __m256i backslash = _mm256_set1_epi8('\\');
+					const __m256i quote = _mm256_set1_epi8('"');
+					const __m256i case_bit = _mm256_set1_epi8(0x20);
+					const __m256i open = _mm256_set1_epi8('{');
+					const __m256i close = _mm256_set1_epi8('}');
+					const __m256i colon = _mm256_set1_epi8(':');
+					const __m256i comma = _mm256_set1_epi8(',');
+
+					Masks masks;
+					for (std::size_t i = 0; i < block_size; i += 32)
+					{
+						const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+						const __m256i folded = _mm256_or_si256(data, case_bit);
+						const __m256i structural = _mm256_or_si256(
+							_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+							_mm256_or_si256(_mm256_cmpeq_epi8(data, colon), _mm256_cmpeq_epi8(data, comma)));
+
+						masks.backslash |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, backslash)))) << i;
+						masks.quote |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, quote)))) << i;
+						masks.structural |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(structural))) << i;
+					}
+					return masks;
+				}
+#endif
+
+				// each bit becomes the xor of itself and of all the bits below
+				static std::uint64_t prefixXor(std::uint64_t bits)
+				{
+					bits ^= bits << 1;
+					bits ^= bits << 2;
+					bits ^= bits << 4;
+					bits ^= bits << 8;
+					bits ^= bits << 16;
+					bits ^= bits << 32;
+					return bits;
+				}
+
+				static unsigned int trailingZeros(const std::uint64_t bits)
+				{
+#if defined(_MSC_VER)
+					unsigned long index;
+					_BitScanForward64(&index, bits);
+					return static_cast<unsigned int>(index);
+#else
+					return static_cast<unsigned int>(__builtin_ctzll(bits));
+#endif
+				}
+
+				std::vector<std::uint32_t> m_positions;
+				std::size_t m_size{ 0 };
+				bool m_valid{ false };
+			};
+
+			// The Reader walks a json text once, value by value, without copying it.
+			// Every read consumes exactly one value, or marks the reader as failed and stops it.
+			// The trailing commas written by the Serializer are accepted.
+			// Given the StructuralIndex of the text, it jumps over the strings and the skipped values
+			// from one structural position to the next instead of reading them byte by byte.
+
+			class Reader
+			{
+			public:
+				explicit Reader(const std::string_view text)
+					: m_text{ text }
+				{}
+
+				// the index must be built from the same text and outlive the reader
+				Reader(const std::string_view text, const StructuralIndex& index)
+					: m_text{ text }
+					, m_structure{ index.isValid() && index.getSize() == text.size() ? &index : nullptr }
+				{}
+
+				// consume the opening brace of an object, false if the next value is not an object
+				bool beginObject()
+				{
+					return consume(lgraphb);
+				}
+
+				// read the key of the next member, false once the closing brace is consumed
+				// the key is valid until the next read
+				bool nextKey(std::string_view& key)
+				{
+					if (!nextMember(rgraphb)) return false;
+
+					if (!readStringView(key) || !consume(colon))
+					{
+						fail();
+						return false;
+					}
+					return true;
+				}
+
+				// consume the opening bracket of an array, false if the next value is not an array
+				bool beginArray()
+				{
+					return consume(lsquareb);
+				}
+
+				// false once the closing bracket is consumed
+				bool nextElement()
+				{
+					return nextMember(rsquareb);
+				}
+
+				// the first character of the next value, without consuming it, 0 at the end of the text
+				char peek()
+				{
+					skipSpaces();
+					return m_index < m_text.size() ? m_text[m_index] : '\0';
+				}
+
+				// consume a null value
+				bool readNull()
+				{
+					return consumeLiteral("null");
+				}
+
+				bool readBool(bool& value)
+				{
+					if (consumeLiteral("true"))
+					{
+						value = true;
+						return true;
+					}
+					if (consumeLiteral("false"))
+					{
+						value = false;
+						return true;
+					}
+					fail();
+					return false;
+				}
+
+				// the characters of the next number, empty if the next value is not a number
+				std::string_view readNumber()
+				{
+					skipSpaces();
+					const std::size_t begin = m_index;
+					while (m_index < m_text.size() && isNumberCharacter(m_text[m_index]))
+					{
+						++m_index;
+					}
+					if (m_index == begin)
+					{
+						fail();
+					}
+					return m_text.substr(begin, m_index - begin);
+				}
+
+				bool readString(std::string& value)
+				{
+					std::string_view view;
+					if (!readStringView(view))
+					{
+						fail();
+						return false;
+					}
+					value.assign(view.data(), view.size());
+					return true;
+				}
+
+				// skip the next value, whatever it is
+				void skipValue()
+				{
+					if (m_structure != nullptr)
+					{
+						skipSpaces();
+						if (m_index < m_text.size() && (m_text[m_index] == lgraphb || m_text[m_index] == lsquareb))
+						{
+							skipContainer();
+							return;
+						}
+					}
+
+					std::size_t depth = 0;
+					do
+					{
+						skipSpaces();
+						if (m_index >= m_text.size())
+						{
+							if (depth > 0) fail();
+							return;
+						}
+
+						const char c = m_text[m_index];
+						if (c == quote)
+						{
+							if (!skipString()) return;
+						}
+						else if (c == lgraphb || c == lsquareb)
+						{
+							++depth;
+							++m_index;
+						}
+						else if (c == rgraphb || c == rsquareb || c == comma || c == colon)
+						{
+							// the closing bracket or separator of the enclosing value
+							if (depth == 0) return;
+							if (c == rgraphb || c == rsquareb) --depth;
+							++m_index;
+						}
+						else
+						{
+							while (m_index < m_text.size() && !isDelimiter(m_text[m_index]))
+							{
+								++m_index;
+							}
+						}
+					} while (depth > 0);
+				}
+
+				inline bool hasFailed() const { return m_failed; }
+				inline std::size_t getIndex() const { return m_index; }
+				// move back to a position returned by getIndex, to read a value twice
+				inline void setIndex(const std::size_t index) { m_index = (std::min)(index, m_text.size()); }
+
+			private:
+				void fail()
+				{
+					m_failed = true;
+					m_index = m_text.size();
+				}
+
+				void skipSpaces()
+				{
+					while (m_index < m_text.size() && isSpace(m_text[m_index]))
+					{
+						++m_index;
+					}
+				}
+
+				bool consume(const char c)
+				{
+					skipSpaces();
+					if (m_index < m_text.size() && m_text[m_index] == c)
+					{
+						++m_index;
+						return true;
+					}
+					return false;
+				}
+
+				bool consumeLiteral(const std::string_view literal)
+				{
+					skipSpaces();
+					if (m_text.compare(m_index, literal.size(), literal) != 0) return false;
+
+					const std::size_t end = m_index + literal.size();
+					if (end < m_text.size() && !isDelimiter(m_text[end])) return false;
+
+					m_index = end;
+					return true;
+				}
+
+				// skip the separator before the next member, consume the closing character after the last one
+				bool nextMember(const char closing)
+				{
+					if (m_failed) return false;
+
+					consume(comma);
+					skipSpaces();
+					if (m_index >= m_text.size())
+					{
+						fail();
+						return false;
+					}
+					if (m_text[m_index] == closing)
+					{
+						++m_index;
+						return false;
+					}
+					return true;
+				}
+
+				// the view points in the text, or in the scratch buffer if the string has escapes
+				bool readStringView(std::string_view& value)
+				{
+					skipSpaces();
+					if (m_index >= m_text.size() || m_text[m_index] != quote) return false;
+
+					if (m_structure != nullptr)
+					{
+						// the closing quote is the next position, the text between is used as is without backslashes
+						const std::vector<std::uint32_t>& positions = m_structure->getPositions();
+						const std::size_t k = findStructural(m_index);
+						if (k + 1 < positions.size() && positions[k] == m_index)
+						{
+							const std::size_t begin = m_index + 1;
+							const std::size_t end = positions[k + 1];
+							if (std::memchr(m_text.data() + begin, backslash, end - begin) == nullptr)
+							{
+								value = m_text.substr(begin, end - begin);
+								m_index = end + 1;
+								m_cursor = k + 2;
+								return true;
+							}
+						}
+					}
+
+					const std::size_t begin = ++m_index;
+					while (m_index < m_text.size() && m_text[m_index] != quote && m_text[m_index] != backslash)
+					{
+						++m_index;
+					}
+					if (m_index >= m_text.size()) return false;
+
+					if (m_text[m_index] == quote)
+					{
+						value = m_text.substr(begin, m_index - begin);
+						++m_index;
+						return true;
+					}
+
+					m_scratch.assign(m_text.data() + begin, m_index - begin);
+					while (m_index < m_text.size() && m_text[m_index] != quote)
+					{
+						const char c = m_text[m_index++];
+						if (c != backslash)
+						{
+							m_scratch.push_back(c);
+							continue;
+						}
+						if (m_index >= m_text.size()) return false;
+
+						switch (const char escaped = m_text[m_index++])
+						{
+						case 'b': m_scratch.push_back('\b'); break;
+						case 'f': m_scratch.push_back('\f'); break;
+						case 'n': m_scratch.push_back('\n'); break;
+						case 'r': m_scratch.push_back('\r'); break;
+						case 't': m_scratch.push_back('\t'); break;
+						case 'u': if (!readCodePoint()) return false; break;
+						default: m_scratch.push_back(escaped); break;
+						}
+					}
+					if (m_index >= m_text.size()) return false;
+
+					++m_index;
+					value = m_scratch;
+					return true;
+				}
+
+				bool skipString()
+				{
+					if (m_structure != nullptr)
+					{
+						const std::vector<std::uint32_t>& positions = m_structure->getPositions();
+						const std::size_t k = findStructural(m_index);
+						if (k + 1 < positions.size() && positions[k] == m_index)
+						{
+							m_index = positions[k + 1] + 1;
+							m_cursor = k + 2;
+							return true;
+						}
+					}
+
+					++m_index;
+					while (m_index < m_text.size() && m_text[m_index] != quote)
+					{
+						m_index += m_text[m_index] == backslash ? 2 : 1;
+					}
+					if (m_index >= m_text.size())
+					{
+						fail();
+						return false;
+					}
+					++m_index;
+					return true;
+				}
+
+				// jump past the bracket closing the one at the reading index
+				void skipContainer()
+				{
+					const std::vector<std::uint32_t>& positions = m_structure->getPositions();
+					std::size_t depth = 0;
+					for (std::size_t k = findStructural(m_index); k < positions.size(); ++k)
+					{
+						const char c = m_text[positions[k]];
+						if (c == lgraphb || c == lsquareb)
+						{
+							++depth;
+						}
+						else if ((c == rgraphb || c == rsquareb) && --depth == 0)
+						{
+							m_index = positions[k] + 1;
+							m_cursor = k + 1;
+							return;
+						}
+					}
+					fail();
+				}
+
+				// the first indexed position at or after the given text index
+				// the reading index mostly moves forward, only setIndex moves the cursor back
+				std::size_t findStructural(const std::size_t index)
+				{
+					const std::vector<std::uint32_t>& positions = m_structure->getPositions();
+					if (m_cursor > 0 && positions[m_cursor - 1] >= index)
+					{
+						m_cursor = std::lower_bound(positions.begin(), positions.begin() + m_cursor, index) - positions.begin();
+					}
+					while (m_cursor < positions.size() && positions[m_cursor] < index)
+					{
+						++m_cursor;
+					}
+					return m_cursor;
+				}
+
+				// append the utf-8 encoding of a \uXXXX escape, joining the surrogate pairs
+				bool readCodePoint()
+				{
+					std::uint32_t code{ 0 };
+					if (!readHex(code)) return false;
+					if (code >= 0xd800 && code < 0xdc00 && m_text.compare(m_index, 2, "\\u") == 0)
+					{
+						m_index += 2;
+						std::uint32_t low{ 0 };
+						if (!readHex(low) || low < 0xdc00 || low >= 0xe000) return false;
+						code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+					}
+
+					if (code < 0x80)
+					{
+						m_scratch.push_back(static_cast<char>(code));
+					}
+					else if (code < 0x800)
+					{
+						m_scratch.push_back(static_cast<char>(0xc0 | (code >> 6)));
+						m_scratch.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+					}
+					else if (code < 0x10000)
+					{
+						m_scratch.push_back(static_cast<char>(0xe0 | (code >> 12)));
+						m_scratch.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+						m_scratch.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+					}
+					else
+					{
+						m_scratch.push_back(static_cast<char>(0xf0 | (code >> 18)));
+						m_scratch.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+						m_scratch.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+						m_scratch.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+					}
+					return true;
+				}
+
+				bool readHex(std::uint32_t& value)
+				{
+					if (m_text.size() - m_index < 4) return false;
+
+					for (int i = 0; i < 4; ++i)
+					{
+						const char c = m_text[m_index++];
+						value <<= 4;
+						if (c >= '0' && c <= '9') value |= c - '0';
+						else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+						else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+						else return false;
+					}
+					return true;
+				}
+
+				static bool isSpace(const char c)
+				{
+					return c == space || c == endline || c == tab || c == '\r';
+				}
+
+				static bool isDelimiter(const char c)
+				{
+					return isSpace(c) || c == comma || c == colon || c == rgraphb || c == rsquareb || c == quote || c == lgraphb || c == lsquareb;
+				}
+
+				static bool isNumberCharacter(const char c)
+				{
+					return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+				}
+
+				static constexpr char backslash = '\\';
+				static constexpr char colon = ':';
+				static constexpr char comma = ',';
+				static constexpr char endline = '\n';
+				static constexpr char lgraphb = '{';
+				static constexpr char lsquareb = '[';
+				static constexpr char quote = '"';
+				static constexpr char rgraphb = '}';
+				static constexpr char rsquareb = ']';
+				static constexpr char space = ' ';
+				static constexpr char tab = '\t';
+
+				std::string_view m_text;
+				std::size_t m_index{ 0 };
+				// structural positions of the text if given, and the first one not behind the reading index
+				const StructuralIndex* m_structure{ nullptr };
+				std::size_t m_cursor{ 0 };
+				// unescaped copy of the last string with escapes
+				std::string m_scratch;
+				bool m_failed{ false };
+			};
+
+			// The Writer appends json to a string owned by the caller, nested values are written in place.
+			// The pretty mode breaks the objects in indented lines, the compact one writes no whitespace.
+
+			class Writer
+			{
+			public:
+				explicit Writer(std::string& output, const bool compact = false, const std::string_view offset = {})
+					: m_output{ output }
+					, m_compact{ compact }
+					, m_offset{ offset }
+				{}
+
+				void beginObject()
+				{
+					prefix();
+					m_output.push_back('{');
+					++m_depth;
+					m_separator = false;
+				}
+
+				void endObject()
+				{
+					--m_depth;
+					if (m_separator)
+					{
+						newline();
+					}
+					m_output.push_back('}');
+					m_separator = true;
+				}
+
+				void key(const std::string_view name)
+				{
+					if (m_separator)
+					{
+						m_output.push_back(',');
+					}
+					newline();
+					appendString(name);
+					m_output.append(m_compact ? ":" : ": ");
+					m_key = true;
+				}
+
+				void beginArray()
+				{
+					prefix();
+					m_output.push_back('[');
+					++m_depth;
+					m_separator = false;
+				}
+
+				void endArray()
+				{
+					--m_depth;
+					m_output.push_back(']');
+					m_separator = true;
+				}
+
+				void null()
+				{
+					prefix();
+					m_output.append("null");
+				}
+
+				void value(const bool data)
+				{
+					prefix();
+					m_output.append(data ? "true" : "false");
+				}
+
+				void value(const std::string_view data)
+				{
+					prefix();
+					appendString(data);
+				}
+
+				void value(const char* const data)
+				{
+					value(std::string_view(data));
+				}
+
+				template<typename T>
+				void number(const T data)
+				{
+					prefix();
+					char buffer[max_number_size];
+					m_output.append(formatNumber(buffer, data));
+				}
+
+				// the shortest text of a number that reads back to the same value, in a buffer of max_number_size characters
+				// it does not depend on the locale
+				static constexpr std::size_t max_number_size = 64;
+
+				template<typename T>
+				static std::string_view formatNumber(char* const buffer, const T data)
+				{
+					static_assert(std::is_arithmetic<T>::value, "Number write only supports arithmetic data type");
+
+					if constexpr (std::is_floating_point<T>::value)
+					{
+						// json has no literal for them
+						if (!std::isfinite(data))
+						{
+							buffer[0] = '0';
+							return std::string_view(buffer, 1);
+						}
+#if defined(__cpp_lib_to_chars)
+						const std::to_chars_result result = std::to_chars(buffer, buffer + max_number_size, data);
+						return std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+#else
+						// standard libraries without floating point to_chars
+						const int size = std::snprintf(buffer, max_number_size, "%.*g", std::numeric_limits<T>::max_digits10, static_cast<double>(data));
+						return std::string_view(buffer, static_cast<std::size_t>(std::clamp<int>(size, 0, max_number_size - 1)));
+#endif
+					}
+					else if constexpr (std::is_same<T, bool>::value)
+					{
+						return data ? "1" : "0";
+					}
+					else
+					{
+						const std::to_chars_result result = std::to_chars(buffer, buffer + max_number_size, data);
+						return std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+					}
+				}
 
-				const std::size_t amount = std::min<std::size_t>(sizeof(T), getSize());
-				if (amount > 0)
+				inline bool isCompact() const { return m_compact; }
+				inline std::size_t size() const { return m_output.size(); }
+
+			private:
+				// the separator before a value, none after a key
+				void prefix()
 				{
-					std::memcpy(&data, &m_buffer[m_index], amount);
-					m_index += amount;
+					if (m_key)
+					{
+						m_key = false;
+					}
+					else if (m_separator)
+					{
+						m_output.append(m_compact ? "," : ", ");
+					}
+					m_separator = true;
 				}
 
-				return *this;
-			}
+				void newline()
+				{
+					if (m_compact) return;
 
-			InputByteStream& operator>> (std::string& data)
-			{
-				std::size_t characters{ 0 };
-				*this >> characters;
+					m_output.push_back('\n');
+					m_output.append(m_offset);
+					m_output.append(m_depth * 4, ' ');
+				}
 
-				const std::size_t amount = std::min<std::size_t>(characters, getSize());
-				if (amount > 0)
+				// quote the string, escaping the characters json does not allow as they are
+				void appendString(const std::string_view data)
 				{
-					data = std::string(reinterpret_cast<const char*>(&m_buffer[m_index]), amount);
-					m_index += amount;
-				}
+					static constexpr char hex[] = "0123456789abcdef";
 
-				return *this;
-			}
+					m_output.push_back('"');
+					std::size_t begin = 0;
+					for (std::size_t i = 0; i < data.size(); ++i)
+					{
+						const unsigned char c = static_cast<unsigned char>(data[i]);
+						if (c >= 0x20 && c != '"' && c != '\\') continue;
 
-			inline std::size_t getIndex() const { return m_index; }
-			inline std::size_t getSize() const { return m_buffer.size() - m_index; }
+						m_output.append(data.data() + begin, i - begin);
+						begin = i + 1;
+						switch (c)
+						{
+						case '"': m_output.append("\\\""); break;
+						case '\\': m_output.append("\\\\"); break;
+						case '\b': m_output.append("\\b"); break;
+						case '\f': m_output.append("\\f"); break;
+						case '\n': m_output.append("\\n"); break;
+						case '\r': m_output.append("\\r"); break;
+						case '\t': m_output.append("\\t"); break;
+						default:
+							m_output.append("\\u00");
+							m_output.push_back(hex[c >> 4]);
+							m_output.push_back(hex[c & 0x0f]);
+							break;
+						}
+					}
+					m_output.append(data.data() + begin, data.size() - begin);
+					m_output.push_back('"');
+				}
 
-		private:
-			// reading byte index
-			std::size_t m_index;
-		};
+				std::string& m_output;
+				bool m_compact;
+				// prefix of the lines in pretty mode
+				std::string_view m_offset;
+				std::size_t m_depth{ 0 };
+				// whether the next value follows another one, or a key
+				bool m_separator{ false };
+				bool m_key{ false };
+			};
 
-		namespace json
-		{
 			struct Serializer final
 			{
 				Serializer() = delete;
@@ -485,7 +3903,8 @@ namespace reflect
 					}
 					else
 					{
-						return std::to_string(value);
+						char buffer[Writer::max_number_size];
+						return std::string(Writer::formatNumber(buffer, value));
 					}
 				}
 
@@ -593,6 +4012,110 @@ namespace reflect
 					return result.append("}");
 				}
 
+				// write the value as the next one of the writer
+
+				template <typename T>
+				static void write(Writer& writer, const T& value)
+				{
+					if constexpr (std::is_base_of<IType, T>::value)
+					{
+						value.to_json(writer);
+					}
+					else if constexpr (std::is_arithmetic<T>::value)
+					{
+						writer.number(value);
+					}
+					else
+					{
+						// the types without reflection write nothing
+						const std::size_t size = writer.size();
+						Type<T>::to_json(writer, value);
+						if (writer.size() == size)
+						{
+							writer.null();
+						}
+					}
+				}
+
+				static void write(Writer& writer, const bool value)
+				{
+					writer.value(value);
+				}
+
+				static void write(Writer& writer, const char* const value)
+				{
+					writer.value(std::string_view(value));
+				}
+
+				static void write(Writer& writer, const std::string& value)
+				{
+					writer.value(std::string_view(value));
+				}
+
+				template <typename T = IType>
+				static void write(Writer& writer, const std::shared_ptr<T>& value)
+				{
+					if (value == nullptr)
+					{
+						writer.null();
+						return;
+					}
+					value->to_json(writer);
+				}
+
+				template <typename T = IType>
+				static void write(Writer& writer, const std::unique_ptr<T>& value)
+				{
+					if (value == nullptr)
+					{
+						writer.null();
+						return;
+					}
+					value->to_json(writer);
+				}
+
+				template <typename T>
+				static void write(Writer& writer, const std::list<T>& value)
+				{
+					writer.beginArray();
+					for (const auto& element : value)
+					{
+						write(writer, element);
+					}
+					writer.endArray();
+				}
+
+				template <typename T>
+				static void write(Writer& writer, const std::vector<T>& value)
+				{
+					writer.beginArray();
+					for (const auto& element : value)
+					{
+						write(writer, element);
+					}
+					writer.endArray();
+				}
+
+				template <typename K, typename V>
+				static void write(Writer& writer, const std::map<K, V>& object)
+				{
+					writer.beginObject();
+					for (const auto& pair : object)
+					{
+						if constexpr (std::is_same<K, std::string>::value)
+						{
+							writer.key(pair.first);
+						}
+						else
+						{
+							char buffer[Writer::max_number_size];
+							writer.key(Writer::formatNumber(buffer, pair.first));
+						}
+						write(writer, pair.second);
+					}
+					writer.endObject();
+				}
+
 				static constexpr char* comma = ",";
 				static constexpr char* equals = ":";
 				static constexpr char* quote = "\"";
@@ -613,15 +4136,73 @@ namespace reflect
 					}
 					else
 					{
-						value = static_cast<T>(std::stod(source));
+						std::string_view text(source);
+						const std::size_t begin = text.find_first_not_of(" \t\r\n");
+						text = begin != std::string_view::npos ? text.substr(begin) : std::string_view{};
+						parse_number(text.substr(0, text.find_first_of(" \t\r\n,}]")), value);
 					}
 				}
 
 				static void parse(const std::string& source, bool& value)
 				{
-					static const std::string pattern{ "true" };
+					std::string_view text(source);
+					const std::size_t begin = text.find_first_not_of(" \t\r\n");
+					text = begin != std::string_view::npos ? text.substr(begin, 4) : std::string_view{};
+					value = text.size() == 4
+						&& std::equal(text.begin(), text.end(), "true", [](const char a, const char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+				}
 
-					value = to_lower(source).find(pattern) != std::string::npos;
+				// parse the whole text as a number without locale, false if it is not one
+				// integers written with a fraction or an exponent are truncated
+				template <typename T>
+				static bool parse_number(const std::string_view text, T& value)
+				{
+					const char* const begin = text.data();
+					const char* const end = begin + text.size();
+					if constexpr (std::is_enum<T>::value)
+					{
+						std::underlying_type_t<T> number{};
+						if (!parse_number(text, number)) return false;
+						value = static_cast<T>(number);
+						return true;
+					}
+					else if constexpr (std::is_same<T, bool>::value)
+					{
+						long long number{ 0 };
+						if (!parse_number(text, number)) return false;
+						value = number != 0;
+						return true;
+					}
+					else if constexpr (std::is_floating_point<T>::value)
+					{
+#if defined(__cpp_lib_to_chars)
+						const std::from_chars_result result = std::from_chars(begin, end, value);
+						return result.ec == std::errc() && result.ptr == end;
+#else
+						// standard libraries without floating point from_chars, the text is not null terminated
+						char buffer[Writer::max_number_size]{};
+						if (text.empty() || text.size() >= sizeof(buffer)) return false;
+						text.copy(buffer, text.size());
+						char* parsed = nullptr;
+						const double number = std::strtod(buffer, &parsed);
+						if (parsed != buffer + text.size()) return false;
+						value = static_cast<T>(number);
+						return true;
+#endif
+					}
+					else
+					{
+						const std::from_chars_result result = std::from_chars(begin, end, value);
+						if (result.ec == std::errc() && result.ptr == end) return true;
+						if (result.ec == std::errc::result_out_of_range) return false;
+
+						double number{ 0 };
+						if (!parse_number(text, number)
+							|| number < static_cast<double>(std::numeric_limits<T>::lowest())
+							|| number > static_cast<double>((std::numeric_limits<T>::max)())) return false;
+						value = static_cast<T>(number);
+						return true;
+					}
 				}
 
 				static void parse(const std::string& source, std::string& value)
@@ -632,120 +4213,237 @@ namespace reflect
 				template <typename T = IType>
 				static void parse(const std::string& source, std::shared_ptr<T>& value)
 				{
-					if (value == nullptr)
+					Reader reader(source);
+					read(reader, value);
+				}
+
+				template <typename T = IType>
+				static void parse(const std::string& source, std::unique_ptr<T>& value)
+				{
+					Reader reader(source);
+					read(reader, value);
+				}
+
+				template <typename T>
+				static void parse(const std::string& source, std::list<T>& list)
+				{
+					Reader reader(source);
+					read(reader, list);
+				}
+
+				template <typename T>
+				static void parse(const std::string& source, std::vector<T>& list)
+				{
+					Reader reader(source);
+					read(reader, list);
+				}
+
+				template <typename K, typename V>
+				static void parse(const std::string& source, std::map<K, V>& obj)
+				{
+					Reader reader(source);
+					read(reader, obj);
+				}
+
+				// decode the next value of the reader, a value of another kind is skipped and the value left as is
+				// a container read replaces the elements of the value
+
+				template <typename T>
+				static void read(Reader& reader, T& value)
+				{
+					if constexpr (std::is_base_of<IType, T>::value)
+					{
+						value.from_json(reader);
+					}
+					else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
 					{
-						std::string temp;
-						if (find_value(source, "type_id", temp))
+						const char c = reader.peek();
+						if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.')
 						{
-							std::string type_id;
-							parse(temp, type_id);
-							if (type_id == Type<T>::name())
-							{
-								value = std::make_shared<T>();
-							}
-							else
-							{
-								value = std::shared_ptr<T>(TypeFactory::instantiate<T>(type_id));
-								if (value == nullptr) return;
-							}
+							reader.skipValue();
+							return;
 						}
-						else
+
+						parse_number(reader.readNumber(), value);
+					}
+					else
+					{
+						const std::size_t index = reader.getIndex();
+						Type<T>::read_json(reader, value);
+						if (reader.getIndex() == index)
 						{
-							value = std::make_shared<T>();
+							reader.skipValue();
 						}
 					}
-					value->from_json(source);
+				}
+
+				static void read(Reader& reader, bool& value)
+				{
+					const char c = reader.peek();
+					if (c != 't' && c != 'f')
+					{
+						reader.skipValue();
+						return;
+					}
+					reader.readBool(value);
+				}
+
+				static void read(Reader& reader, std::string& value)
+				{
+					if (reader.peek() != '"')
+					{
+						reader.skipValue();
+						return;
+					}
+					reader.readString(value);
 				}
 
 				template <typename T = IType>
-				static void parse(const std::string& source, std::unique_ptr<T>& value)
+				static void read(Reader& reader, std::shared_ptr<T>& value)
 				{
+					if (reader.readNull())
+					{
+						value = nullptr;
+						return;
+					}
+					if (reader.peek() != '{')
+					{
+						reader.skipValue();
+						return;
+					}
 					if (value == nullptr)
 					{
-						std::string temp;
-						if (find_value(source, "type_id", temp))
+						value = std::shared_ptr<T>(instantiate<T>(reader));
+						if (value == nullptr)
 						{
-							std::string type_id;
-							parse(temp, type_id);
-							if (type_id == Type<T>::name())
-							{
-								value = std::make_unique<T>();
-							}
-							else
-							{
-								value = std::unique_ptr<T>(TypeFactory::instantiate<T>(type_id));
-								if (value == nullptr) return;
-							}
+							reader.skipValue();
+							return;
 						}
-						else
+					}
+					value->from_json(reader);
+				}
+
+				template <typename T = IType>
+				static void read(Reader& reader, std::unique_ptr<T>& value)
+				{
+					if (reader.readNull())
+					{
+						value = nullptr;
+						return;
+					}
+					if (reader.peek() != '{')
+					{
+						reader.skipValue();
+						return;
+					}
+					if (value == nullptr)
+					{
+						value = std::unique_ptr<T>(instantiate<T>(reader));
+						if (value == nullptr)
 						{
-							value = std::make_unique<T>();
+							reader.skipValue();
+							return;
 						}
 					}
-					value->from_json(source);
+					value->from_json(reader);
 				}
 
 				template <typename T>
-				static void parse(const std::string& source, std::list<T>& list)
+				static void read(Reader& reader, std::list<T>& list)
 				{
-					std::string src{ trim(source, space) };
-					src = src.substr(1, src.length() - 2);
-
-					size_t index = 0;
-					std::string element_source;
-					while (!src.empty() && (index = next_value(src, element_source)) != std::string::npos)
+					if (!reader.beginArray())
+					{
+						reader.skipValue();
+						return;
+					}
+					list.clear();
+					while (reader.nextElement())
 					{
 						T element;
-						parse(element_source, element);
+						read(reader, element);
 						list.push_back(std::move(element));
-						const size_t minIndex = src.length() < index + 1 ? src.length() : index + 1;
-						src = src.substr(minIndex);
-					};
+					}
 				}
 
 				template <typename T>
-				static void parse(const std::string& source, std::vector<T>& list)
+				static void read(Reader& reader, std::vector<T>& list)
 				{
-					std::string src{ trim(source, space) };
-					src = src.substr(1, src.length() - 2);
-
-					size_t index = 0;
-					std::string element_source;
-					while (!src.empty() && (index = next_value(src, element_source)) != std::string::npos)
+					if (!reader.beginArray())
+					{
+						reader.skipValue();
+						return;
+					}
+					list.clear();
+					while (reader.nextElement())
 					{
 						T element;
-						parse(element_source, element);
+						read(reader, element);
 						list.push_back(std::move(element));
-						const size_t minIndex = src.length() < index + 1 ? src.length() : index + 1;
-						src = src.substr(minIndex);
-					};
+					}
 				}
 
 				template <typename K, typename V>
-				static void parse(const std::string& source, std::map<K, V>& obj)
+				static void read(Reader& reader, std::map<K, V>& obj)
+				{
+					if (!reader.beginObject())
+					{
+						reader.skipValue();
+						return;
+					}
+					obj.clear();
+					std::string_view key_source;
+					while (reader.nextKey(key_source))
+					{
+						// the key view does not survive the reading of the value
+						K key;
+						read_key(key_source, key);
+						V value;
+						read(reader, value);
+						obj.insert({ std::move(key), std::move(value) });
+					}
+				}
+
+				template <typename K>
+				static void read_key(const std::string_view source, K& key)
 				{
-					std::string src{ trim(source, space) };
+					if constexpr (std::is_same<K, std::string>::value)
+					{
+						key.assign(source.data(), source.size());
+					}
+					else
+					{
+						Reader reader(source);
+						read(reader, key);
+					}
+				}
 
-					size_t index = 0;
-					std::string key_source, value_source;
-					while ((index = next_key(src, key_source)) != std::string::npos)
+				// create the object of the type named by the type_id member, T if there is none
+				template <typename T>
+				static T* instantiate(Reader& reader)
+				{
+					const std::size_t index = reader.getIndex();
+					std::string type_id;
+					bool found = false;
+					std::string_view key;
+					if (reader.beginObject())
 					{
-						src = src.substr(index + 2);
-						index = next_value(src, value_source);
-						if (index != std::string::npos)
-						{
-							K key;
-							parse(key_source, key);
-							V value;
-							parse(value_source, value);
-							obj.insert({ std::move(key), std::move(value) });
-							src = src.substr(index + 1);
-						}
-						else
+						while (reader.nextKey(key))
 						{
-							break;
+							if (key == "type_id")
+							{
+								found = reader.readString(type_id);
+								break;
+							}
+							reader.skipValue();
 						}
-					};
+					}
+					reader.setIndex(index);
+
+					if (found && type_id != Type<T>::name())
+					{
+						return TypeFactory::instantiate<T>(type_id);
+					}
+					return new T();
 				}
 
 				static bool is_array(const std::string& source)
@@ -943,6 +4641,109 @@ namespace reflect
 		}
 	}
 
+	inline std::string IType::to_string(const encoding::ByteFormat& format) const
+	{
+		encoding::ByteBuffer buffer;
+		encoding::OutputByteStream stream(buffer, format);
+		stream.reserve(binary_size(format));
+		to_bytes(stream);
+		return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	}
+
+	// The ITrackedType is the base of the types declared with CLASS(Tracked).
+	// The generated setters mark the changed properties in a dirty mask,
+	// the binary and json forms are cached until the next change.
+	// Properties modified without a setter must be marked with mark_dirty.
+
+	struct ITrackedType : public IType
+	{
+		ITrackedType() = default;
+
+		// one bit per serialized property, the properties beyond the 63rd share the last bit
+		static constexpr std::uint64_t dirty_bit(const std::size_t index)
+		{
+			return std::uint64_t{ 1 } << (std::min<std::size_t>)(index, 63);
+		}
+
+		inline std::uint64_t dirty_mask() const { return m_dirty; }
+		inline bool is_dirty() const { return m_dirty != 0; }
+
+		void mark_dirty(const std::uint64_t mask = ~std::uint64_t{ 0 })
+		{
+			m_dirty |= mask;
+			invalidate_cache();
+		}
+
+		// acknowledge the changes once saved, the cached forms stay valid
+		void clear_dirty() { m_dirty = 0; }
+
+		// drop the cached forms without marking a change, as the decoders do
+		void invalidate_cache()
+		{
+			m_bytes_cached = false;
+			m_json_cached = false;
+		}
+
+	protected:
+
+		// the cached bytes are reused while the format matches,
+		// references depend on the objects written before and are never cached
+		template<typename W>
+		void write_cached(encoding::OutputByteStream& stream, W write) const
+		{
+			const encoding::ByteFormat& format = stream.getFormat();
+			if (format.references)
+			{
+				write(stream);
+				return;
+			}
+
+			if (!isCached(format))
+			{
+				m_bytes.clear();
+				encoding::OutputByteStream cache(m_bytes, format);
+				write(cache);
+				m_bytes_format = format;
+				m_bytes_cached = true;
+			}
+			stream.writeBytes(m_bytes);
+		}
+
+		template<typename S>
+		std::size_t binary_size_cached(const encoding::ByteFormat& format, S size) const
+		{
+			return isCached(format) ? m_bytes.size() : size();
+		}
+
+		template<typename J>
+		std::string to_json_cached(const std::string& offset, J to_json) const
+		{
+			if (!m_json_cached || m_json_offset != offset)
+			{
+				m_json = to_json();
+				m_json_offset = offset;
+				m_json_cached = true;
+			}
+			return m_json;
+		}
+
+	private:
+		bool isCached(const encoding::ByteFormat& format) const
+		{
+			return m_bytes_cached && m_bytes_format.compact == format.compact && m_bytes_format.tagged == format.tagged;
+		}
+
+		// new objects are dirty until saved
+		std::uint64_t m_dirty{ ~std::uint64_t{ 0 } };
+
+		mutable encoding::ByteBuffer m_bytes;
+		mutable encoding::ByteFormat m_bytes_format;
+		mutable bool m_bytes_cached{ false };
+		mutable std::string m_json;
+		mutable std::string m_json_offset;
+		mutable bool m_json_cached{ false };
+	};
+
 #define ENUM(...)
 #define CLASS(...)
 #define NATIVE_CLASS(T, ...)
@@ -952,10 +4753,17 @@ namespace reflect
 	template <typename T> \
 	friend struct Type; \
 	virtual const meta_t& type_meta() const override; \
+	virtual type_id_t type_id() const override; \
 	virtual const char* const type_name() const override; \
 	virtual const properties_t& type_properties() const override; \
 	virtual operator std::string() const override; \
 	virtual void from_string(const std::string& str) override; \
+	virtual void from_bytes(encoding::InputByteStream& stream) override; \
+	virtual void from_bytes_body(encoding::InputByteStream& stream) override; \
+	virtual void to_bytes(encoding::OutputByteStream& stream) const override; \
+	virtual std::size_t binary_size(const encoding::ByteFormat& format) const override; \
 	virtual void from_json(const std::string& json) override; \
-	virtual std::string to_json(const std::string& offset = "") const override;
+	virtual void from_json(encoding::json::Reader& reader) override; \
+	virtual std::string to_json(const std::string& offset = "") const override; \
+	virtual void to_json(encoding::json::Writer& writer) const override;
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <cassert>
 #include <iostream>
 #include <vdtreflect/runtime.h>
 
@@ -96,4 +97,518 @@ int main()
 			cout << element->type_name() << endl;
 		}
 	}
+
+	cout << "Testing delta encoding" << endl;
+	{
+		Poo baseline;
+		baseline.dictionary = { { "a", 1 }, { "b", 2 } };
+		baseline.list = { 1, 2, 3 };
+		baseline.type.dictionary = { { "x", 7 } };
+		baseline.foos.resize(2);
+		baseline.s_type = std::make_shared<Foo>();
+		baseline.u_type = std::make_unique<Foo>();
+		baseline.unique_foos.push_back(std::make_unique<Poo>());
+		baseline.m_string = "kept";
+		baseline.c = 20;
+
+		Poo current;
+		current.m_string = "kept";
+		current.c = 20;
+		current.dictionary = { { "a", 100 } };
+		current.list = { 1, 3 };
+		current.type.dictionary = { { "y", 8 } };
+		current.foos.resize(2);
+		current.foos[1].m_int = 42;
+		current.s_type = std::make_shared<Foo>();
+		current.s_type->m_int = 9;
+		current.u_type = std::make_unique<Foo>();
+		auto derived = std::make_unique<Poo>();
+		derived->c = 16;
+		current.unique_foos.push_back(std::move(derived));
+
+		for (const bool compact : { false, true })
+		{
+			for (const bool tagged : { false, true })
+			{
+				reflect::encoding::ByteFormat format;
+				format.compact = compact;
+				format.tagged = tagged;
+
+				reflect::encoding::ByteBuffer buffer;
+				reflect::encoding::OutputByteStream out(buffer, format);
+				const bool changed = reflect::Type<Poo>::write_delta(baseline, current, out);
+
+				Poo target;
+				reflect::Type<Poo>::from_string(reflect::Type<Poo>::to_string(baseline, format), target, format);
+				reflect::encoding::InputByteStream in(buffer, format);
+				reflect::Type<Poo>::apply_delta(baseline, in, target);
+
+				assert(changed);
+				assert(target.dictionary == current.dictionary);
+				assert(target.list == current.list);
+				assert(target.type.dictionary == current.type.dictionary);
+				assert(target.foos.size() == 2 && target.foos[1].m_int == 42);
+				assert(target.s_type && target.s_type->m_int == 9);
+				assert(target.unique_foos.size() == 1 && dynamic_cast<Poo*>(target.unique_foos[0].get())->c == 16);
+
+				// the unchanged properties of a fresh object come from the baseline
+				Poo fresh;
+				reflect::encoding::InputByteStream again(buffer, format);
+				reflect::Type<Poo>::apply_delta(baseline, again, fresh);
+				assert(fresh.m_string == "kept" && fresh.c == 20);
+				assert(fresh.dictionary == current.dictionary && fresh.type.dictionary == current.type.dictionary);
+				assert(fresh.foos.size() == 2 && fresh.foos[1].m_int == 42);
+				assert(fresh.s_type && fresh.s_type->m_int == 9);
+
+				// distinct pointers to equal objects are no change
+				reflect::encoding::ByteBuffer unchanged;
+				reflect::encoding::OutputByteStream probe(unchanged, format);
+				assert(!reflect::Type<Poo>::write_delta(current, target, probe));
+				cout << "compact " << compact << ", tagged " << tagged << ": " << buffer.size() << " bytes" << endl;
+			}
+		}
+	}
+
+	cout << "Testing tracked caches" << endl;
+	{
+		Profile saved;
+		saved.name = "hero";
+		saved.level = 42;
+		saved.items = { 1, 2, 3 };
+		const std::string bytes = reflect::Type<Profile>::to_string(saved);
+		const std::string json = reflect::Type<Profile>::to_json(saved, "");
+
+		// every decoding path drops the cached forms of the object it overwrites
+		Profile profile;
+		const std::string stale = profile.to_string();
+		const std::string staleJson = profile.to_json();
+
+		reflect::encoding::InputByteStream in(bytes);
+		reflect::Type<Profile>::read(in, profile);
+		assert(profile.level == 42 && profile.to_string() == bytes);
+
+		Profile parsed;
+		assert(parsed.to_json() == staleJson);
+		reflect::Type<Profile>::from_json(json, parsed);
+		assert(parsed.level == 42 && parsed.to_json() == json);
+
+		std::stringstream archive;
+		{
+			reflect::encoding::ArchiveWriter writer(archive);
+			writer.add(saved, "saved");
+		}
+		const std::string content = archive.str();
+		reflect::encoding::ArchiveReader reader(content);
+		Profile loaded;
+		assert(loaded.to_string() == stale && loaded.to_json() == staleJson);
+		assert(reader.read(reader.find("saved"), loaded));
+		assert(loaded.to_string() == bytes && loaded.to_json() == json);
+		cout << "cached forms follow the decoded objects" << endl;
+	}
+
+	cout << "Testing json values of another kind" << endl;
+	{
+		// a mismatched value is skipped, the members after it are still read
+		Poo poo;
+		poo.list = { 9 };
+		poo.from_json("{ \"m_int\": \"7\", \"m_bool\": true, \"c\": [1, { \"x\": \"]\" }], \"s_type\": 3, \"m_enum\": null,"
+			" \"tuple\": \"none\", \"dictionary\": [1], \"list\": [1, 2], \"samples\": { \"a\": 1 }, \"m_string\": \"after\" }");
+		assert(poo.m_int == 4 && poo.c == 15 && poo.s_type == nullptr && poo.m_enum == TestEnum::A);
+		assert(poo.m_bool && poo.m_string == "after");
+		assert((poo.list == std::list<int>{ 1, 2 }));
+
+		Foo foo;
+		foo.from_json("{ \"m_bool\": \"yes\", \"m_string\": 5, \"m_int\": 12 }");
+		assert(!foo.m_bool && foo.m_string == "foo" && foo.m_int == 12);
+		cout << poo.m_string << " " << foo.m_int << endl;
+	}
+
+	cout << "Testing compact encoding" << endl;
+	{
+		Poo poo;
+		poo.m_int = 300;
+		poo.m_string = std::string(200, 'x');
+		poo.samples = { 0.5f, 1.5f };
+		poo.u_type = std::make_unique<Foo>();
+		poo.u_type->m_int = -1;
+
+		reflect::encoding::ByteFormat compact;
+		compact.compact = true;
+		const std::string bytes = reflect::Type<Poo>::to_string(poo, compact);
+		assert(reflect::Type<Poo>::binary_size(poo, compact) == bytes.size());
+		assert(bytes.size() < reflect::Type<Poo>::to_string(poo).size());
+
+		Poo decoded;
+		reflect::Type<Poo>::from_string(bytes, decoded, compact);
+		assert(decoded.m_int == 300 && decoded.m_string == poo.m_string && decoded.samples == poo.samples);
+		assert(decoded.u_type && decoded.u_type->m_int == -1);
+		assert(reflect::encoding::Varint::decode<int>(reflect::encoding::Varint::encode(-123456)) == -123456);
+		cout << bytes.size() << " bytes" << endl;
+	}
+
+	cout << "Testing tagged encoding" << endl;
+	{
+		Poo poo;
+		poo.m_int = 7;
+		poo.m_string = "tagged";
+		poo.c = 21;
+		poo.foos.resize(2);
+
+		reflect::encoding::ByteFormat tagged;
+		tagged.tagged = true;
+		const std::string bytes = reflect::Type<Poo>::to_string(poo, tagged);
+		assert(reflect::Type<Poo>::binary_size(poo, tagged) == bytes.size());
+
+		Poo decoded;
+		reflect::Type<Poo>::from_string(bytes, decoded, tagged);
+		assert(decoded.c == 21 && decoded.foos.size() == 2 && decoded.m_string == "tagged");
+
+		// a reader with another schema keeps the fields it knows and skips the others
+		Foo foo;
+		reflect::encoding::InputByteStream in(bytes, tagged);
+		reflect::type_id_t id{ 0 };
+		in.readFixed(id);
+		reflect::Type<Foo>::read_body(in, foo);
+		assert(id == reflect::Type<Poo>::id() && foo.m_int == 7 && foo.m_string == "tagged");
+		cout << bytes.size() << " bytes" << endl;
+	}
+
+	cout << "Testing streamed encoding" << endl;
+	{
+		Poo poo;
+		poo.m_string = "streamed";
+		poo.samples.assign(100, 1.0f);
+		const std::string expected = reflect::Type<Poo>::to_string(poo);
+
+		// small chunks flush the buffer to the stream and refill the window from it
+		std::stringstream file;
+		{
+			reflect::encoding::ByteBuffer chunk;
+			reflect::encoding::OutputByteStream out(chunk, file, {}, 64);
+			for (int i = 0; i < 3; ++i)
+			{
+				reflect::Type<Poo>::write(out, poo);
+			}
+		}
+		assert(file.str() == expected + expected + expected);
+
+		reflect::encoding::ByteBuffer window;
+		reflect::encoding::InputByteStream in(window, file, {}, 64);
+		for (int i = 0; i < 3; ++i)
+		{
+			Poo decoded;
+			reflect::Type<Poo>::read(in, decoded);
+			assert(decoded.m_string == "streamed" && decoded.samples.size() == 100);
+		}
+		cout << file.str().size() << " bytes through a " << window.size() << " bytes window" << endl;
+	}
+
+	cout << "Testing memory resources" << endl;
+	{
+		Poo poo;
+		poo.shared_foos.push_back(std::make_shared<Foo>());
+		poo.shared_foos.push_back(std::make_shared<Poo>());
+		poo.s_type = std::make_shared<Foo>();
+		poo.s_type->m_int = 5;
+		const std::string bytes = reflect::Type<Poo>::to_string(poo);
+
+		// the shared objects are allocated in the arena, which must outlive them
+		std::byte storage[4096];
+		std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+		{
+			reflect::encoding::InputByteStream in(bytes);
+			in.setResource(&arena);
+			Poo decoded;
+			reflect::Type<Poo>::read(in, decoded);
+
+			const auto inArena = [&storage](const void* const object)
+				{
+					const std::less<const void*> less;
+					return !less(object, storage) && less(object, storage + sizeof(storage));
+				};
+			assert(decoded.shared_foos.size() == 2 && inArena(decoded.shared_foos[1].get()));
+			assert(decoded.s_type && decoded.s_type->m_int == 5 && inArena(decoded.s_type.get()));
+			assert(reflect::Type<Poo>::to_string(decoded) == bytes);
+		}
+		cout << "shared objects allocated from the arena" << endl;
+	}
+
+	cout << "Testing parallel decoding" << endl;
+	{
+		Too too;
+		for (int i = 0; i < 1000; ++i)
+		{
+			too.types.push_back(i % 3 == 0 ? std::make_unique<Poo>() : std::make_unique<Foo>());
+			too.types.back()->m_int = i;
+		}
+		too.types[5] = nullptr;
+		const std::string bytes = reflect::Type<Too>::to_string(too);
+
+		reflect::encoding::InputByteStream in(bytes);
+		in.setThreads(4);
+		Too decoded;
+		reflect::Type<Too>::read(in, decoded);
+		assert(decoded.types.size() == 1000 && decoded.types[5] == nullptr);
+		assert(decoded.types[999]->m_int == 999 && dynamic_cast<Poo*>(decoded.types[999].get()) != nullptr);
+		assert(reflect::Type<Too>::to_string(decoded) == bytes);
+		cout << decoded.types.size() << " elements decoded on 4 threads" << endl;
+	}
+
+	cout << "Testing archives" << endl;
+	{
+		Poo poo;
+		poo.m_string = "archived";
+		std::stringstream file;
+		{
+			reflect::encoding::ArchiveWriter writer(file);
+			for (int i = 0; i < 10; ++i)
+			{
+				Foo foo;
+				foo.m_int = i;
+				writer.add(foo, i == 7 ? "seven" : "");
+			}
+			const IType& type = poo;
+			writer.add(type, "poo");
+		}
+
+		// the entries are read in any order through the table of contents
+		const std::string content = file.str();
+		reflect::encoding::ArchiveReader reader(content);
+		assert(reader.isValid() && reader.size() == 11);
+		Foo foo;
+		assert(reader.read("seven", foo) && foo.m_int == 7);
+		assert(reader.read(2, foo) && foo.m_int == 2);
+		assert(!reader.read(11, foo) && reader.find("missing") == reflect::encoding::ArchiveReader::npos);
+		const std::unique_ptr<IType> object = reader.instantiate("poo");
+		assert(object && static_cast<Poo*>(object.get())->m_string == "archived");
+
+		const std::string truncated = content.substr(0, content.size() - 3);
+		assert(!reflect::encoding::ArchiveReader(truncated).isValid());
+		cout << reader.size() << " entries in " << content.size() << " bytes" << endl;
+	}
+
+	cout << "Testing lazy views" << endl;
+	{
+		Poo poo;
+		poo.m_string = "lazy";
+		poo.c = 33;
+		poo.samples = { 1.0f, 2.0f };
+		poo.unique_foos.push_back(std::make_unique<Foo>());
+
+		reflect::encoding::ByteFormat tagged;
+		tagged.tagged = true;
+		const std::string bytes = reflect::Type<Poo>::to_string(poo, tagged);
+
+		// only the requested fields are decoded
+		reflect::Type<Poo>::LazyView view(bytes, tagged);
+		assert(view.isValid());
+		assert(view.get(&Poo::c) == 33 && view.get(&Poo::m_string) == "lazy");
+		assert(view.object().samples.empty() && view.object().unique_foos.empty());
+		assert(view.get(&Poo::samples) == poo.samples && view.get(&Poo::unique_foos).size() == 1);
+
+		assert(!reflect::Type<Foo>::LazyView(bytes, tagged).isValid());
+		assert(!reflect::Type<Poo>::LazyView(bytes, {}).isValid());
+		cout << view.get(&Poo::m_string) << " " << view.get(&Poo::c) << endl;
+	}
+
+	cout << "Testing flat layout" << endl;
+	{
+		Poo poo;
+		poo.m_int = 12;
+		poo.m_string = "flat";
+		poo.samples = { 1.0f, 2.0f, 3.0f };
+		poo.position.x = 4.0f;
+		poo.foos.resize(2);
+		poo.foos[1].m_string = "second";
+
+		// the accessors read the buffer in place, without decoding it
+		const reflect::encoding::ByteBuffer buffer = reflect::Type<Poo>::to_flat(poo);
+		const reflect::Type<Poo>::Flat flat(buffer);
+		assert(flat.isValid() && flat.m_int() == 12 && flat.m_string() == "flat");
+		assert(flat.samples().size() == 3 && flat.samples()[2] == 3.0f);
+		assert(reflect::Type<math::vec2>::Flat(flat.position()).x() == 4.0f);
+		assert(flat.foos().size() == 2 && reflect::Type<Foo>::Flat(flat.foos()[1]).m_string() == "second");
+
+		// out of range reads give default values
+		assert(flat.samples()[3] == 0.0f && !flat.foos()[2].isValid());
+		const std::string truncated(reinterpret_cast<const char*>(buffer.data()), 3);
+		assert(!reflect::Type<Poo>::Flat(truncated).isValid() && reflect::Type<Poo>::Flat(truncated).m_int() == 0);
+		cout << buffer.size() << " bytes" << endl;
+	}
+
+	cout << "Testing shared references" << endl;
+	{
+		auto shared = std::make_shared<Poo>();
+		shared->m_string = "shared";
+		// a cycle, broken before leaving the scope
+		shared->s_type = shared;
+
+		Poo poo;
+		poo.shared_foos = { shared, std::make_shared<Foo>(), shared };
+		poo.s_type = shared;
+
+		reflect::encoding::ByteFormat references;
+		references.references = true;
+		const std::string bytes = reflect::Type<Poo>::to_string(poo, references);
+
+		Poo decoded;
+		reflect::Type<Poo>::from_string(bytes, decoded, references);
+		assert(decoded.shared_foos.size() == 3 && decoded.shared_foos[0] == decoded.shared_foos[2]);
+		assert(decoded.s_type == decoded.shared_foos[0] && decoded.shared_foos[1] != decoded.shared_foos[0]);
+		Poo* const object = static_cast<Poo*>(decoded.shared_foos[0].get());
+		assert(object->m_string == "shared" && object->s_type.get() == object);
+		assert(reflect::Type<Poo>::to_string(decoded, references) == bytes);
+
+		object->s_type = nullptr;
+		shared->s_type = nullptr;
+		cout << bytes.size() << " bytes" << endl;
+	}
+
+	cout << "Testing compression" << endl;
+	{
+		Poo poo;
+		poo.m_string = "compressed";
+		poo.samples.assign(500, 0.25f);
+		const std::string bytes = reflect::Type<Poo>::to_string(poo);
+
+		const reflect::encoding::ByteView view(bytes);
+		reflect::encoding::ByteBuffer packed, unpacked;
+		reflect::encoding::Lz::compress(view, packed);
+		assert(packed.size() < bytes.size());
+		assert(reflect::encoding::Lz::decompress(packed, unpacked));
+		assert(std::equal(unpacked.begin(), unpacked.end(), view.data, view.data + view.size) && unpacked.size() == view.size);
+
+		const reflect::encoding::ByteBuffer truncated(packed.begin(), packed.begin() + packed.size() / 2);
+		assert(!reflect::encoding::Lz::decompress(truncated, unpacked));
+
+		// the stream buffers compress the payloads on their way to the file
+		std::stringstream file;
+		{
+			reflect::encoding::LzOutputStreamBuffer lz(file);
+			std::ostream compressed(&lz);
+			reflect::encoding::ByteBuffer chunk;
+			reflect::encoding::OutputByteStream out(chunk, compressed);
+			reflect::Type<Poo>::write(out, poo);
+		}
+		reflect::encoding::LzInputStreamBuffer lz(file);
+		std::istream decompressed(&lz);
+		reflect::encoding::ByteBuffer window;
+		reflect::encoding::InputByteStream in(window, decompressed);
+		Poo decoded;
+		reflect::Type<Poo>::read(in, decoded);
+		assert(lz.isValid() && decoded.m_string == "compressed" && decoded.samples == poo.samples);
+		cout << bytes.size() << " -> " << packed.size() << " bytes" << endl;
+	}
+
+	cout << "Testing checksums" << endl;
+	{
+		// the standard check value of crc32c
+		const std::string digits = "123456789";
+		assert(reflect::encoding::Crc32c::compute(digits) == 0xE3069283u);
+
+		Poo poo;
+		poo.m_string = "checked";
+		std::stringstream file;
+		{
+			reflect::encoding::ArchiveWriter writer(file, {}, true);
+			writer.add(poo, "poo");
+		}
+		std::string content = file.str();
+		assert(reflect::encoding::ArchiveReader(content).hasChecksum());
+		Poo decoded;
+		assert(reflect::encoding::ArchiveReader(content).read("poo", decoded) && decoded.m_string == "checked");
+
+		// a flipped bit is caught, unless the verification is skipped
+		content[content.size() / 2] ^= 1;
+		assert(!reflect::encoding::ArchiveReader(content).isValid());
+		assert(reflect::encoding::ArchiveReader(content, false).isValid());
+		cout << std::hex << reflect::encoding::Crc32c::compute(digits) << std::dec << endl;
+	}
+
+	cout << "Testing compact json" << endl;
+	{
+		Poo poo;
+		poo.m_string = "with spaces";
+		poo.foos.resize(2);
+		const std::string pretty = poo.to_json();
+
+		// the writer appends to a string owned by the caller, reused across documents
+		std::string compact;
+		for (int i = 0; i < 2; ++i)
+		{
+			compact.clear();
+			reflect::encoding::json::Writer writer(compact, true);
+			reflect::Type<Poo>::to_json(writer, poo);
+		}
+		assert(compact.size() < pretty.size() && compact.find('\n') == std::string::npos);
+		assert(compact.find("\"m_string\":\"with spaces\"") != std::string::npos);
+
+		Poo decoded;
+		decoded.from_json(compact);
+		assert(decoded.m_string == "with spaces" && decoded.foos.size() == 2 && decoded.to_json() == pretty);
+		cout << compact.size() << " vs " << pretty.size() << " bytes" << endl;
+	}
+
+	cout << "Testing json numbers" << endl;
+	{
+		// the shortest text that reads back to the same value
+		const std::vector<double> doubles{ 0.1 + 0.2, 1e-300, -123456.789 };
+		const std::vector<float> floats{ 0.1f, -0.5f };
+		std::string text;
+		{
+			reflect::encoding::json::Writer writer(text, true);
+			writer.beginObject();
+			writer.key("doubles");
+			reflect::encoding::json::Serializer::write(writer, doubles);
+			writer.key("floats");
+			reflect::encoding::json::Serializer::write(writer, floats);
+			writer.endObject();
+		}
+		assert(text.find("0.30000000000000004") != std::string::npos && text.find("[0.1,") != std::string::npos);
+
+		std::vector<double> parsedDoubles;
+		std::vector<float> parsedFloats;
+		reflect::encoding::json::Reader reader(text);
+		std::string_view key;
+		assert(reader.beginObject());
+		while (reader.nextKey(key))
+		{
+			if (key == "doubles") reflect::encoding::json::Deserializer::read(reader, parsedDoubles);
+			else reflect::encoding::json::Deserializer::read(reader, parsedFloats);
+		}
+		assert(parsedDoubles == doubles && parsedFloats == floats);
+
+		int integer = 0;
+		float real = 0.0f;
+		reflect::encoding::json::Deserializer::parse(" 42.0 ", integer);
+		reflect::encoding::json::Deserializer::parse("2.5e1", real);
+		assert(integer == 42 && real == 25.0f);
+		cout << text << endl;
+	}
+
+	cout << "Testing json structural index" << endl;
+	{
+		// quotes and brackets inside the strings, escaped or not, are not structural
+		const std::string small = "{ \"a\": \"x\\\"]}\", \"b\": [1, 2] }";
+		const reflect::encoding::json::StructuralIndex smallIndex(small);
+		const std::vector<std::uint32_t> expected{ 0, 2, 4, 5, 7, 13, 14, 16, 18, 19, 21, 23, 26, 28 };
+		assert(smallIndex.isValid() && smallIndex.getPositions() == expected);
+		assert(!reflect::encoding::json::StructuralIndex("{ \"open").isValid());
+
+		// unknown members are skipped by jumping over their structural characters
+		std::string document = "{ \"unknown\": [";
+		for (int i = 0; i < 1000; ++i)
+		{
+			document += "{ \"s\": \"\\\\\\\"]}{[\", \"n\": [1, 2] },";
+		}
+		document += "], \"m_string\": \"indexed\", \"m_int\": 77 }";
+
+		const reflect::encoding::json::StructuralIndex index(document);
+		reflect::encoding::json::Reader reader(document, index);
+		Poo poo;
+		poo.from_json(reader);
+		assert(index.isValid() && !reader.hasFailed());
+		assert(poo.m_string == "indexed" && poo.m_int == 77);
+		cout << index.getPositions().size() << " structural characters in " << document.size() << " bytes" << endl;
+	}
 }
\ No newline at end of file
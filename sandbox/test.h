@@ -47,6 +47,7 @@ struct Poo : public Foo
 	PROPERTY() int c = 15;
 	PROPERTY() std::tuple<int, float, bool, double> tuple;
 	PROPERTY() std::map<std::string, std::vector<int>> power_dictionary;
+	PROPERTY() std::vector<float> samples;
 	PROPERTY() std::vector<std::shared_ptr<Foo>> shared_foos;
 	PROPERTY() std::vector<std::unique_ptr<Foo>> unique_foos;	
 	PROPERTY() Foo type;
@@ -71,4 +72,14 @@ enum class ApplicationMode : int
 	Editor = 0,
 	Server = 1,
 	Standalone = 2,
-};
\ No newline at end of file
+};
+
+CLASS(Tracked)
+struct Profile : public ITrackedType
+{
+	PROPERTY() std::string name;
+	PROPERTY() int level{ 1 };
+	PROPERTY() std::vector<int> items;
+
+	GENERATED_BODY()
+};
@@ -21,6 +21,8 @@ const reflect::meta_t& reflect::Type<math::vec2>::meta()
     };
     return s_meta;
 }
+reflect::type_id_t reflect::Type<math::vec2>::id() { return 0xff69fe1af0a54eabull; }
+std::uint64_t reflect::Type<math::vec2>::schema() { return 0xeeb6f7dc0f2d4fdcull; }
 const char* const reflect::Type<math::vec2>::name() { return "math::vec2"; }
 
 const reflect::properties_t& Type<math::vec2>::properties()
@@ -37,796 +39,3246 @@ std::size_t reflect::Type<math::vec2>::size()
     return sizeof(math::vec2);
 }
 
-void reflect::Type<math::vec2>::from_string(const std::string& str, math::vec2& type)
+void reflect::Type<math::vec2>::from_string(const std::string& str, math::vec2& type, const reflect::encoding::ByteFormat& format)
 {
-    reflect::encoding::ByteBuffer buffer;
-    std::transform(
-        std::begin(str),
-        std::end(str),
-        std::back_inserter(buffer),
-        [](const char c)
-        {
-            return std::byte(c);
-        }
-    );
-    
-    reflect::encoding::InputByteStream stream(buffer);
-    std::string _name;
-    stream >> _name;
-    if (_name != name()) return;
-    
-    stream >> type.x;
-    stream >> type.y;
+    from_bytes(str, type, format);
 }
 
-std::string reflect::Type<math::vec2>::to_string(const math::vec2& type)
+void reflect::Type<math::vec2>::from_bytes(const reflect::encoding::ByteView& view, math::vec2& type, const reflect::encoding::ByteFormat& format)
 {
-    reflect::encoding::ByteBuffer buffer;
-    reflect::encoding::OutputByteStream stream(buffer);
-    stream << name();
-    
-    stream << type.x;
-    stream << type.y;
-    
-    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
+    reflect::encoding::InputByteStream stream(view, format);
+    read(stream, type);
 }
 
-void reflect::Type<math::vec2>::from_json(const std::string& json, math::vec2& type)
+void reflect::Type<math::vec2>::read(reflect::encoding::InputByteStream& stream, math::vec2& type)
 {
-    std::string src{ reflect::encoding::json::Deserializer::trim(json, reflect::encoding::json::Deserializer::space) };
-    
-    size_t index = 0;
-    std::string key;
-    while ((index = reflect::encoding::json::Deserializer::next_key(src, key)) != std::string::npos)
+    reflect::type_id_t _id{ 0 };
+    stream.readFixed(_id);
+    if (_id != id()) return;
+    read_body(stream, type);
+}
+
+void reflect::Type<math::vec2>::read_body(reflect::encoding::InputByteStream& stream, math::vec2& type)
+{
+    if (stream.getFormat().tagged)
     {
-        src = src.substr(index + 2);
-        src = reflect::encoding::json::Deserializer::ltrim(src, reflect::encoding::json::Deserializer::space);
-        std::string value;
-        index = reflect::encoding::json::Deserializer::next_value(src, value);
-        if (index != std::string::npos)
+        std::uint64_t _schema{ 0 };
+        std::size_t _fields{ 0 };
+        stream.readFixed(_schema);
+        stream >> _fields;
+        // the writer had a different schema, match the fields by tag and skip the unknown ones
+        if (_schema != schema())
         {
-            if (key == "x") reflect::encoding::json::Deserializer::parse(value, type.x);
-            if (key == "y") reflect::encoding::json::Deserializer::parse(value, type.y);
-            src = src.substr(index + 1);
+            for (std::size_t _i = 0; _i < _fields; ++_i)
+            {
+                std::uint32_t _tag{ 0 };
+                const std::size_t field = stream.beginField(_tag);
+                read_field(stream, type, _tag);
+                stream.endField(field);
+            }
+            return;
         }
-        else break;
-    };
+    }
+    
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.x;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.y;
+        stream.endField(field);
+    }
 }
 
-std::string reflect::Type<math::vec2>::to_json(const math::vec2& type, const std::string& offset)
+void reflect::Type<math::vec2>::read_field(reflect::encoding::InputByteStream& stream, math::vec2& type, const std::uint32_t tag)
 {
-    std::stringstream stream;
-    stream << "{" << std::endl;
-    stream << offset << "    " << "\"type_id\": " << "\"math::vec2\"" << "," << std::endl;
-    stream << offset << "    " << "\"x\": " << reflect::encoding::json::Serializer::to_string(type.x) << "," << std::endl;
-    stream << offset << "    " << "\"y\": " << reflect::encoding::json::Serializer::to_string(type.y) << "," << std::endl;
-    stream << offset << "}";
-    return stream.str();
+    switch (tag)
+    {
+    case 0x2961e24bu:
+    {
+        stream >> type.x;
+        break;
+    }
+    case 0x2961e118u:
+    {
+        stream >> type.y;
+        break;
+    }
+    default: break;
+    }
 }
 
-IType* const reflect::Type<Foo>::instantiate()
+std::string reflect::Type<math::vec2>::to_string(const math::vec2& type, const reflect::encoding::ByteFormat& format)
 {
-    return dynamic_cast<IType*>(new Foo());
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::OutputByteStream stream(buffer, format);
+    stream.reserve(binary_size(type, format));
+    write(stream, type);
+    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
 }
 
-const reflect::meta_t& reflect::Type<Foo>::meta()
+void reflect::Type<math::vec2>::write(reflect::encoding::OutputByteStream& stream, const math::vec2& type)
 {
-    static reflect::meta_t s_meta {
-        { "Category", "MyClass" },
-        { "Serializable", "true" },
-    };
-    return s_meta;
+    stream.writeFixed(id());
+    if (stream.getFormat().tagged)
+    {
+        stream.writeFixed(schema());
+        stream << std::size_t{ 2 };
+    }
+    
+    {
+        const std::size_t field = stream.beginField(0x2961e24bu);
+        stream << type.x;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x2961e118u);
+        stream << type.y;
+        stream.endField(field);
+    }
 }
-const char* const reflect::Type<Foo>::name() { return "Foo"; }
 
-const reflect::properties_t& Type<Foo>::properties()
+std::size_t reflect::Type<math::vec2>::binary_size(const math::vec2& type, const reflect::encoding::ByteFormat& format)
 {
-    static reflect::properties_t s_properties {
-        { "m_int", reflect::Property{ offsetof(Foo, m_int), reflect::meta_t {{"JsonExport", "true"} }, "m_int", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
-        { "m_enum", reflect::Property{ offsetof(Foo, m_enum), reflect::meta_t { }, "m_enum", reflect::PropertyType{ "TestEnum", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(TestEnum), reflect::PropertyType::Type::T_unknown } } },
-        { "m_bool", reflect::Property{ offsetof(Foo, m_bool), reflect::meta_t { }, "m_bool", reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool } } },
-        { "m_string", reflect::Property{ offsetof(Foo, m_string), reflect::meta_t { }, "m_string", reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string } } },
-        { "list", reflect::Property{ offsetof(Foo, list), reflect::meta_t { }, "list", reflect::PropertyType{ "std::list<int>", { 
-            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::list<int>), reflect::PropertyType::Type::T_template } } },
-        { "dictionary", reflect::Property{ offsetof(Foo, dictionary), reflect::meta_t { }, "dictionary", reflect::PropertyType{ "std::map<std::string, int>", { 
-            reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string },
-            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::map<std::string, int>), reflect::PropertyType::Type::T_template } } },
-        { "position", reflect::Property{ offsetof(Foo, position), reflect::meta_t { }, "position", reflect::PropertyType{ "math::vec2", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(math::vec2), reflect::PropertyType::Type::T_native } } },
-    };
-    return s_properties;
+    std::size_t size = sizeof(reflect::type_id_t);
+    if (format.tagged)
+    {
+        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ 2 }, format);
+    }
+    
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.x, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.y, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    
+    return size;
 }
 
-std::size_t reflect::Type<Foo>::size()
+bool reflect::Type<math::vec2>::write_delta(const math::vec2& baseline, const math::vec2& type, reflect::encoding::OutputByteStream& stream)
 {
-    return sizeof(Foo);
+    std::uint8_t _mask[1] = {};
+    const std::size_t _block = stream.beginBlock();
+    const std::size_t _position = stream.getPosition();
+    stream.writeArray(_mask, 1);
+    if (!(baseline.x == type.x))
+    {
+        _mask[0] |= 0x1;
+        stream << type.x;
+    }
+    if (!(baseline.y == type.y))
+    {
+        _mask[0] |= 0x2;
+        stream << type.y;
+    }
+    stream.patchBytes(_position, _mask, 1);
+    stream.endBlock(_block);
+    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });
 }
 
-void reflect::Type<Foo>::from_string(const std::string& str, Foo& type)
+void reflect::Type<math::vec2>::apply_delta(const math::vec2& baseline, reflect::encoding::InputByteStream& stream, math::vec2& type)
 {
-    reflect::encoding::ByteBuffer buffer;
-    std::transform(
-        std::begin(str),
-        std::end(str),
-        std::back_inserter(buffer),
-        [](const char c)
-        {
-            return std::byte(c);
-        }
-    );
-    
-    reflect::encoding::InputByteStream stream(buffer);
-    std::string _name;
-    stream >> _name;
-    if (_name != name()) return;
-    
-    stream >> type.m_int;
-    stream >> type.m_bool;
-    stream >> type.m_string;
-    {
-        type.list.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
-        {
-            int element;
-            stream >> element;
-            type.list.push_back(std::move(element));
-        }
-    }
+    std::uint8_t _mask[1] = {};
+    const std::size_t _end = stream.beginBlock();
+    stream.readArray(_mask, 1);
+    if (_mask[0] & 0x1)
     {
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
-        {
-            std::string key;
-            stream >> key;
-            int value;
-            stream >> value;
-            type.dictionary.insert(std::make_pair(key, value));
-        }
+        stream >> type.x;
     }
+    else reflect::encoding::Delta::assign(type.x, baseline.x);
+    if (_mask[0] & 0x2)
     {
-        std::string pack;
-        stream >> pack;
-        reflect::Type<math::vec2>::from_string(pack, type.position);
+        stream >> type.y;
     }
+    else reflect::encoding::Delta::assign(type.y, baseline.y);
+    stream.endBlock(_end);
 }
 
-std::string reflect::Type<Foo>::to_string(const Foo& type)
+reflect::encoding::ByteBuffer reflect::Type<math::vec2>::to_flat(const math::vec2& type)
 {
     reflect::encoding::ByteBuffer buffer;
-    reflect::encoding::OutputByteStream stream(buffer);
-    stream << name();
-    
-    stream << type.m_int;
-    stream << type.m_bool;
-    stream << type.m_string;
+    reflect::encoding::FlatBuilder builder(buffer);
+    builder.finish(write_flat(builder, type));
+    return buffer;
+}
+
+std::size_t reflect::Type<math::vec2>::write_flat(reflect::encoding::FlatBuilder& builder, const math::vec2& type)
+{
+    const std::size_t table = builder.beginTable(2);
+    builder.addScalar(table, 0, type.x);
+    builder.addScalar(table, 1, type.y);
+    return table;
+}
+
+float reflect::Type<math::vec2>::Flat::x() const
+{
+    return m_table.scalar<float>(0);
+}
+float reflect::Type<math::vec2>::Flat::y() const
+{
+    return m_table.scalar<float>(1);
+}
+
+void reflect::Type<math::vec2>::from_json(const std::string& json, math::vec2& type)
+{
+    reflect::encoding::json::Reader reader(json);
+    read_json(reader, type);
+}
+
+void reflect::Type<math::vec2>::read_json(reflect::encoding::json::Reader& reader, math::vec2& type)
+{
+    if (!reader.beginObject())
     {
-        stream << type.list.size();
-        for (const auto& element : type.list)
-        {
-            stream << element;
-        }
+        reader.skipValue();
+        return;
     }
+
+    std::string_view key;
+    while (reader.nextKey(key))
     {
-        stream << type.dictionary.size();
-        for (const auto& pair : type.dictionary)
+        switch (key.size())
         {
-            stream << pair.first;
-            stream << pair.second;
+        case 1:
+            switch (key[0])
+            {
+            case 'x':
+                if (key == "x") { reflect::encoding::json::Deserializer::read(reader, type.x); continue; }
+                break;
+            case 'y':
+                if (key == "y") { reflect::encoding::json::Deserializer::read(reader, type.y); continue; }
+                break;
+            }
+            break;
         }
+        reader.skipValue();
     }
-    stream << reflect::Type<math::vec2>::to_string(type.position);
-    
-    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
 }
 
-void reflect::Type<Foo>::from_json(const std::string& json, Foo& type)
+std::string reflect::Type<math::vec2>::to_json(const math::vec2& type, const std::string& offset)
 {
-    std::string src{ reflect::encoding::json::Deserializer::trim(json, reflect::encoding::json::Deserializer::space) };
-    
-    size_t index = 0;
-    std::string key;
-    while ((index = reflect::encoding::json::Deserializer::next_key(src, key)) != std::string::npos)
-    {
-        src = src.substr(index + 2);
-        src = reflect::encoding::json::Deserializer::ltrim(src, reflect::encoding::json::Deserializer::space);
-        std::string value;
-        index = reflect::encoding::json::Deserializer::next_value(src, value);
-        if (index != std::string::npos)
-        {
-            if (key == "m_int") reflect::encoding::json::Deserializer::parse(value, type.m_int);
-            if (key == "m_bool") reflect::encoding::json::Deserializer::parse(value, type.m_bool);
-            if (key == "m_string") reflect::encoding::json::Deserializer::parse(value, type.m_string);
-            if (key == "list") reflect::encoding::json::Deserializer::parse(value, type.list);
-            if (key == "dictionary") reflect::encoding::json::Deserializer::parse(value, type.dictionary);
-            if (key == "position") reflect::Type<math::vec2>::from_json(value, type.position);
-            src = src.substr(index + 1);
-        }
-        else break;
-    };
+    std::string json;
+    reflect::encoding::json::Writer writer(json, false, offset);
+    to_json(writer, type);
+    return json;
 }
 
-std::string reflect::Type<Foo>::to_json(const Foo& type, const std::string& offset)
+void reflect::Type<math::vec2>::to_json(reflect::encoding::json::Writer& writer, const math::vec2& type)
 {
-    std::stringstream stream;
-    stream << "{" << std::endl;
-    stream << offset << "    " << "\"type_id\": " << "\"Foo\"" << "," << std::endl;
-    stream << offset << "    " << "\"m_int\": " << reflect::encoding::json::Serializer::to_string(type.m_int) << "," << std::endl;
-    stream << offset << "    " << "\"m_bool\": " << reflect::encoding::json::Serializer::to_string(type.m_bool) << "," << std::endl;
-    stream << offset << "    " << "\"m_string\": " << reflect::encoding::json::Serializer::to_string(type.m_string) << "," << std::endl;
-    stream << offset << "    " << "\"list\": " << reflect::encoding::json::Serializer::to_string(type.list) << "," << std::endl;
-    stream << offset << "    " << "\"dictionary\": " << reflect::encoding::json::Serializer::to_string(type.dictionary) << "," << std::endl;
-    stream << offset << "    " << "\"position\": " << reflect::Type<math::vec2>::to_json(type.position, offset + "    ") << "," << std::endl;
-    stream << offset << "}";
-    return stream.str();
+    writer.beginObject();
+    writer.key("type_id"); writer.value("math::vec2");
+    writer.key("x"); reflect::encoding::json::Serializer::write(writer, type.x);
+    writer.key("y"); reflect::encoding::json::Serializer::write(writer, type.y);
+    writer.endObject();
 }
 
-const reflect::meta_t& Foo::type_meta() const { return reflect::Type<Foo>::meta(); }
-const char* const Foo::type_name() const { return reflect::Type<Foo>::name(); }
-const reflect::properties_t& Foo::type_properties() const { return reflect::Type<Foo>::properties(); }
-Foo::operator std::string() const { return reflect::Type<Foo>::to_string(*this); }
-void Foo::from_string(const std::string& str)
-{
-    reflect::Type<Foo>::from_string(str, *this);
-    type_initialize();
-}
-void Foo::from_json(const std::string& json)
+IType* const reflect::Type<Foo>::instantiate()
 {
-    reflect::Type<Foo>::from_json(json, *this);
-    type_initialize();
+    return dynamic_cast<IType*>(new Foo());
 }
-std::string Foo::to_json(const std::string& offset) const { return reflect::Type<Foo>::to_json(*this, offset); }
 
-IType* const reflect::Type<Poo>::instantiate()
+std::shared_ptr<IType> reflect::Type<Foo>::instantiate_shared(std::pmr::memory_resource* const resource)
 {
-    return dynamic_cast<IType*>(new Poo());
+    if (resource == nullptr) return std::make_shared<Foo>();
+    return std::allocate_shared<Foo>(std::pmr::polymorphic_allocator<Foo>(resource));
 }
 
-const reflect::meta_t& reflect::Type<Poo>::meta()
+const reflect::meta_t& reflect::Type<Foo>::meta()
 {
     static reflect::meta_t s_meta {
+        { "Category", "MyClass" },
+        { "Serializable", "true" },
     };
     return s_meta;
 }
-const char* const reflect::Type<Poo>::name() { return "Poo"; }
+reflect::type_id_t reflect::Type<Foo>::id() { return 0xf2bb95199c92e1d7ull; }
+std::uint64_t reflect::Type<Foo>::schema() { return 0x8d12c50eb948c2b7ull; }
+const char* const reflect::Type<Foo>::name() { return "Foo"; }
 
-const reflect::properties_t& Type<Poo>::properties()
+const reflect::properties_t& Type<Foo>::properties()
 {
     static reflect::properties_t s_properties {
-        // Parent class Foo properties
-        { "m_int", reflect::Property{ offsetof(Poo, m_int), reflect::meta_t {{"JsonExport", "true"} }, "m_int", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
-        { "m_enum", reflect::Property{ offsetof(Poo, m_enum), reflect::meta_t { }, "m_enum", reflect::PropertyType{ "TestEnum", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(TestEnum), reflect::PropertyType::Type::T_unknown } } },
-        { "m_bool", reflect::Property{ offsetof(Poo, m_bool), reflect::meta_t { }, "m_bool", reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool } } },
-        { "m_string", reflect::Property{ offsetof(Poo, m_string), reflect::meta_t { }, "m_string", reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string } } },
-        { "list", reflect::Property{ offsetof(Poo, list), reflect::meta_t { }, "list", reflect::PropertyType{ "std::list<int>", { 
+        { "m_int", reflect::Property{ offsetof(Foo, m_int), reflect::meta_t {{"JsonExport", "true"} }, "m_int", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
+        { "m_enum", reflect::Property{ offsetof(Foo, m_enum), reflect::meta_t { }, "m_enum", reflect::PropertyType{ "TestEnum", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(TestEnum), reflect::PropertyType::Type::T_unknown } } },
+        { "m_bool", reflect::Property{ offsetof(Foo, m_bool), reflect::meta_t { }, "m_bool", reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool } } },
+        { "m_string", reflect::Property{ offsetof(Foo, m_string), reflect::meta_t { }, "m_string", reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string } } },
+        { "list", reflect::Property{ offsetof(Foo, list), reflect::meta_t { }, "list", reflect::PropertyType{ "std::list<int>", { 
             reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
         }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::list<int>), reflect::PropertyType::Type::T_template } } },
-        { "dictionary", reflect::Property{ offsetof(Poo, dictionary), reflect::meta_t { }, "dictionary", reflect::PropertyType{ "std::map<std::string, int>", { 
+        { "dictionary", reflect::Property{ offsetof(Foo, dictionary), reflect::meta_t { }, "dictionary", reflect::PropertyType{ "std::map<std::string, int>", { 
             reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string },
             reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
         }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::map<std::string, int>), reflect::PropertyType::Type::T_template } } },
-        { "position", reflect::Property{ offsetof(Poo, position), reflect::meta_t { }, "position", reflect::PropertyType{ "math::vec2", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(math::vec2), reflect::PropertyType::Type::T_native } } },
-        // Properties
-        { "c", reflect::Property{ offsetof(Poo, c), reflect::meta_t { }, "c", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
-        { "tuple", reflect::Property{ offsetof(Poo, tuple), reflect::meta_t { }, "tuple", reflect::PropertyType{ "std::tuple<int, float, bool, double>", { 
-            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
-            reflect::PropertyType{ "float", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(float), reflect::PropertyType::Type::T_float },
-            reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool },
-            reflect::PropertyType{ "double", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(double), reflect::PropertyType::Type::T_double },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::tuple<int, float, bool, double>), reflect::PropertyType::Type::T_template } } },
-        { "power_dictionary", reflect::Property{ offsetof(Poo, power_dictionary), reflect::meta_t { }, "power_dictionary", reflect::PropertyType{ "std::map<std::string, std::vector<int>>", { 
-            reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string },
-            reflect::PropertyType{ "std::vector<int>", { 
-                reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
-            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<int>), reflect::PropertyType::Type::T_template },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::map<std::string, std::vector<int>>), reflect::PropertyType::Type::T_template } } },
-        { "shared_foos", reflect::Property{ offsetof(Poo, shared_foos), reflect::meta_t { }, "shared_foos", reflect::PropertyType{ "std::vector<std::shared_ptr<Foo>>", { 
-            reflect::PropertyType{ "std::shared_ptr<Foo>", { 
-                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::shared_ptr<Foo>), reflect::PropertyType::Type::T_template },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::shared_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
-        { "unique_foos", reflect::Property{ offsetof(Poo, unique_foos), reflect::meta_t { }, "unique_foos", reflect::PropertyType{ "std::vector<std::unique_ptr<Foo>>", { 
-            reflect::PropertyType{ "std::unique_ptr<Foo>", { 
-                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::unique_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
-        { "type", reflect::Property{ offsetof(Poo, type), reflect::meta_t { }, "type", reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type } } },
-        { "foos", reflect::Property{ offsetof(Poo, foos), reflect::meta_t { }, "foos", reflect::PropertyType{ "std::vector<Foo>", { 
-            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<Foo>), reflect::PropertyType::Type::T_template } } },
-        { "s_type", reflect::Property{ offsetof(Poo, s_type), reflect::meta_t { }, "s_type", reflect::PropertyType{ "std::shared_ptr<Foo>", { 
-            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::shared_ptr<Foo>), reflect::PropertyType::Type::T_template } } },
-        { "u_type", reflect::Property{ offsetof(Poo, u_type), reflect::meta_t { }, "u_type", reflect::PropertyType{ "std::unique_ptr<Foo>", { 
-            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template } } },
+        { "position", reflect::Property{ offsetof(Foo, position), reflect::meta_t { }, "position", reflect::PropertyType{ "math::vec2", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(math::vec2), reflect::PropertyType::Type::T_native } } },
     };
     return s_properties;
 }
 
-std::size_t reflect::Type<Poo>::size()
+std::size_t reflect::Type<Foo>::size()
 {
-    return sizeof(Poo);
+    return sizeof(Foo);
 }
 
-void reflect::Type<Poo>::from_string(const std::string& str, Poo& type)
+void reflect::Type<Foo>::from_string(const std::string& str, Foo& type, const reflect::encoding::ByteFormat& format)
 {
-    reflect::encoding::ByteBuffer buffer;
-    std::transform(
-        std::begin(str),
-        std::end(str),
-        std::back_inserter(buffer),
-        [](const char c)
+    from_bytes(str, type, format);
+}
+
+void reflect::Type<Foo>::from_bytes(const reflect::encoding::ByteView& view, Foo& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::InputByteStream stream(view, format);
+    read(stream, type);
+}
+
+void reflect::Type<Foo>::read(reflect::encoding::InputByteStream& stream, Foo& type)
+{
+    reflect::type_id_t _id{ 0 };
+    stream.readFixed(_id);
+    if (_id != id()) return;
+    read_body(stream, type);
+}
+
+void reflect::Type<Foo>::read_body(reflect::encoding::InputByteStream& stream, Foo& type)
+{
+    if (stream.getFormat().tagged)
+    {
+        std::uint64_t _schema{ 0 };
+        std::size_t _fields{ 0 };
+        stream.readFixed(_schema);
+        stream >> _fields;
+        // the writer had a different schema, match the fields by tag and skip the unknown ones
+        if (_schema != schema())
         {
-            return std::byte(c);
+            for (std::size_t _i = 0; _i < _fields; ++_i)
+            {
+                std::uint32_t _tag{ 0 };
+                const std::size_t field = stream.beginField(_tag);
+                read_field(stream, type, _tag);
+                stream.endField(field);
+            }
+            return;
         }
-    );
-    
-    reflect::encoding::InputByteStream stream(buffer);
-    std::string _name;
-    stream >> _name;
-    if (_name != name()) return;
+    }
     
-    // Parent class Foo properties
-    stream >> type.m_int;
-    stream >> type.m_bool;
-    stream >> type.m_string;
     {
-        type.list.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
-        {
-            int element;
-            stream >> element;
-            type.list.push_back(std::move(element));
-        }
+        const std::size_t field = stream.beginField();
+        stream >> type.m_int;
+        stream.endField(field);
     }
     {
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
-        {
-            std::string key;
-            stream >> key;
-            int value;
-            stream >> value;
-            type.dictionary.insert(std::make_pair(key, value));
-        }
+        const std::size_t field = stream.beginField();
+        stream >> type.m_bool;
+        stream.endField(field);
     }
     {
-        std::string pack;
-        stream >> pack;
-        reflect::Type<math::vec2>::from_string(pack, type.position);
+        const std::size_t field = stream.beginField();
+        stream >> type.m_string;
+        stream.endField(field);
     }
-    // Properties
-    stream >> type.c;
     {
-        type.shared_foos.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
+        const std::size_t field = stream.beginField();
         {
-            std::shared_ptr<Foo> element;
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
             {
-                bool valid = false;
-                stream >> valid;
-                if (valid)
-                {
-                    reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());
-                    std::size_t temp_element_size;
-                    temp_stream >> temp_element_size;
-                    std::string type_id;
-                    temp_stream >> type_id;
-                    if (type_id == Type<Foo>::name())
-                    {
-                        element = std::make_shared<Foo>();
-                    }
-                    else
-                    {
-                        element = std::shared_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
-                    }
-                    {
-                        std::string pack;
-                        stream >> pack;
-                        element->from_string(pack);
-                    }
-                }
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
             }
-            type.shared_foos.push_back(std::move(element));
         }
+        stream.endField(field);
     }
     {
-        type.unique_foos.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
+        const std::size_t field = stream.beginField();
         {
-            std::unique_ptr<Foo> element;
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
             {
-                bool valid = false;
-                stream >> valid;
-                if (valid)
-                {
-                    reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());
-                    std::size_t temp_element_size;
-                    temp_stream >> temp_element_size;
-                    std::string type_id;
-                    temp_stream >> type_id;
-                    if (type_id == Type<Foo>::name())
-                    {
-                        element = std::make_unique<Foo>();
-                    }
-                    else
-                    {
-                        element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
-                    }
-                    {
-                        std::string pack;
-                        stream >> pack;
-                        element->from_string(pack);
-                    }
-                }
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
             }
-            type.unique_foos.push_back(std::move(element));
         }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::Type<math::vec2>::read(stream, type.position);
+            stream.endBlock(end);
+        }
+        stream.endField(field);
+    }
+}
+
+void reflect::Type<Foo>::read_field(reflect::encoding::InputByteStream& stream, Foo& type, const std::uint32_t tag)
+{
+    switch (tag)
+    {
+    case 0xb46c42fdu:
+    {
+        stream >> type.m_int;
+        break;
+    }
+    case 0x8d7eff10u:
+    {
+        stream >> type.m_bool;
+        break;
     }
+    case 0x8902e2b3u:
     {
-        std::string pack;
-        stream >> pack;
-        type.type.from_string(pack);
+        stream >> type.m_string;
+        break;
     }
+    case 0xd6031becu:
     {
-        type.foos.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
         {
-            Foo element;
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
             {
-                std::string pack;
-                stream >> pack;
-                element.from_string(pack);
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
             }
-            type.foos.push_back(std::move(element));
         }
+        break;
     }
+    case 0x4a2becc8u:
     {
-        bool valid = false;
-        stream >> valid;
-        if (valid)
         {
-            reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());
-            std::size_t temp_element_size;
-            temp_stream >> temp_element_size;
-            std::string type_id;
-            temp_stream >> type_id;
-            if (type_id == Type<Foo>::name())
-            {
-                type.s_type = std::make_shared<Foo>();
-            }
-            else
-            {
-                type.s_type = std::shared_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
-            }
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
             {
-                std::string pack;
-                stream >> pack;
-                type.s_type->from_string(pack);
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
             }
         }
+        break;
     }
+    case 0xb01eed6cu:
     {
-        bool valid = false;
-        stream >> valid;
-        if (valid)
         {
-            reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());
-            std::size_t temp_element_size;
-            temp_stream >> temp_element_size;
-            std::string type_id;
-            temp_stream >> type_id;
-            if (type_id == Type<Foo>::name())
-            {
-                type.u_type = std::make_unique<Foo>();
-            }
-            else
-            {
-                type.u_type = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
-            }
-            {
-                std::string pack;
-                stream >> pack;
-                type.u_type->from_string(pack);
-            }
+            const std::size_t end = stream.beginBlock();
+            reflect::Type<math::vec2>::read(stream, type.position);
+            stream.endBlock(end);
         }
+        break;
+    }
+    default: break;
+    }
+}
+
+std::string reflect::Type<Foo>::to_string(const Foo& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::OutputByteStream stream(buffer, format);
+    stream.reserve(binary_size(type, format));
+    write(stream, type);
+    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
+}
+
+void reflect::Type<Foo>::write(reflect::encoding::OutputByteStream& stream, const Foo& type)
+{
+    stream.writeFixed(id());
+    if (stream.getFormat().tagged)
+    {
+        stream.writeFixed(schema());
+        stream << std::size_t{ 6 };
+    }
+    
+    {
+        const std::size_t field = stream.beginField(0xb46c42fdu);
+        stream << type.m_int;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x8d7eff10u);
+        stream << type.m_bool;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x8902e2b3u);
+        stream << type.m_string;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xd6031becu);
+        {
+            stream << type.list.size();
+            for (const auto& element : type.list)
+            {
+                stream << element;
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x4a2becc8u);
+        {
+            stream << type.dictionary.size();
+            for (const auto& pair : type.dictionary)
+            {
+                stream << pair.first;
+                stream << pair.second;
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xb01eed6cu);
+        stream.writeBlock(type.position);
+        stream.endField(field);
+    }
+}
+
+std::size_t reflect::Type<Foo>::binary_size(const Foo& type, const reflect::encoding::ByteFormat& format)
+{
+    std::size_t size = sizeof(reflect::type_id_t);
+    if (format.tagged)
+    {
+        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ 6 }, format);
+    }
+    
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_int, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_bool, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_string, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.list.size(), format);
+            for (const auto& element : type.list)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(element, format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.dictionary.size(), format);
+            for (const auto& pair : type.dictionary)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(pair.first, format);
+                size += reflect::encoding::OutputByteStream::sizeOf(pair.second, format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOfBlock(reflect::Type<math::vec2>::binary_size(type.position, format), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    
+    return size;
+}
+
+bool reflect::Type<Foo>::write_delta(const Foo& baseline, const Foo& type, reflect::encoding::OutputByteStream& stream)
+{
+    std::uint8_t _mask[1] = {};
+    const std::size_t _block = stream.beginBlock();
+    const std::size_t _position = stream.getPosition();
+    stream.writeArray(_mask, 1);
+    if (!(baseline.m_int == type.m_int))
+    {
+        _mask[0] |= 0x1;
+        stream << type.m_int;
+    }
+    if (!(baseline.m_bool == type.m_bool))
+    {
+        _mask[0] |= 0x2;
+        stream << type.m_bool;
+    }
+    if (!(baseline.m_string == type.m_string))
+    {
+        _mask[0] |= 0x4;
+        stream << type.m_string;
+    }
+    if (!(baseline.list == type.list))
+    {
+        _mask[0] |= 0x8;
+        {
+            stream << type.list.size();
+            for (const auto& element : type.list)
+            {
+                stream << element;
+            }
+        }
+    }
+    if (!(baseline.dictionary == type.dictionary))
+    {
+        _mask[0] |= 0x10;
+        {
+            stream << type.dictionary.size();
+            for (const auto& pair : type.dictionary)
+            {
+                stream << pair.first;
+                stream << pair.second;
+            }
+        }
+    }
+    {
+        const std::size_t position = stream.getPosition();
+        if (reflect::Type<math::vec2>::write_delta(baseline.position, type.position, stream)) _mask[0] |= 0x20;
+        else stream.rewind(position);
+    }
+    stream.patchBytes(_position, _mask, 1);
+    stream.endBlock(_block);
+    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });
+}
+
+void reflect::Type<Foo>::apply_delta(const Foo& baseline, reflect::encoding::InputByteStream& stream, Foo& type)
+{
+    std::uint8_t _mask[1] = {};
+    const std::size_t _end = stream.beginBlock();
+    stream.readArray(_mask, 1);
+    if (_mask[0] & 0x1)
+    {
+        stream >> type.m_int;
+    }
+    else reflect::encoding::Delta::assign(type.m_int, baseline.m_int);
+    if (_mask[0] & 0x2)
+    {
+        stream >> type.m_bool;
+    }
+    else reflect::encoding::Delta::assign(type.m_bool, baseline.m_bool);
+    if (_mask[0] & 0x4)
+    {
+        stream >> type.m_string;
+    }
+    else reflect::encoding::Delta::assign(type.m_string, baseline.m_string);
+    if (_mask[0] & 0x8)
+    {
+        {
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.list, baseline.list);
+    if (_mask[0] & 0x10)
+    {
+        {
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.dictionary, baseline.dictionary);
+    if (_mask[0] & 0x20) reflect::Type<math::vec2>::apply_delta(baseline.position, stream, type.position);
+    else reflect::encoding::Delta::assign(type.position, baseline.position);
+    stream.endBlock(_end);
+}
+
+reflect::encoding::ByteBuffer reflect::Type<Foo>::to_flat(const Foo& type)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::FlatBuilder builder(buffer);
+    builder.finish(write_flat(builder, type));
+    return buffer;
+}
+
+std::size_t reflect::Type<Foo>::write_flat(reflect::encoding::FlatBuilder& builder, const Foo& type)
+{
+    const std::size_t table = builder.beginTable(6);
+    builder.addScalar(table, 0, type.m_int);
+    builder.addScalar(table, 1, type.m_bool);
+    builder.addString(table, 2, type.m_string);
+    builder.setSlot(table, 5, reflect::Type<math::vec2>::write_flat(builder, type.position));
+    return table;
+}
+
+int reflect::Type<Foo>::Flat::m_int() const
+{
+    return m_table.scalar<int>(0);
+}
+bool reflect::Type<Foo>::Flat::m_bool() const
+{
+    return m_table.scalar<bool>(1);
+}
+std::string_view reflect::Type<Foo>::Flat::m_string() const
+{
+    return m_table.string(2);
+}
+reflect::encoding::FlatTable reflect::Type<Foo>::Flat::position() const
+{
+    return m_table.table(5);
+}
+
+void reflect::Type<Foo>::from_json(const std::string& json, Foo& type)
+{
+    reflect::encoding::json::Reader reader(json);
+    read_json(reader, type);
+}
+
+void reflect::Type<Foo>::read_json(reflect::encoding::json::Reader& reader, Foo& type)
+{
+    if (!reader.beginObject())
+    {
+        reader.skipValue();
+        return;
+    }
+
+    std::string_view key;
+    while (reader.nextKey(key))
+    {
+        switch (key.size())
+        {
+        case 4:
+            switch (key[0])
+            {
+            case 'l':
+                if (key == "list") { reflect::encoding::json::Deserializer::read(reader, type.list); continue; }
+                break;
+            }
+            break;
+        case 5:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_int") { reflect::encoding::json::Deserializer::read(reader, type.m_int); continue; }
+                break;
+            }
+            break;
+        case 6:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_bool") { reflect::encoding::json::Deserializer::read(reader, type.m_bool); continue; }
+                break;
+            }
+            break;
+        case 8:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_string") { reflect::encoding::json::Deserializer::read(reader, type.m_string); continue; }
+                break;
+            case 'p':
+                if (key == "position") { reflect::Type<math::vec2>::read_json(reader, type.position); continue; }
+                break;
+            }
+            break;
+        case 10:
+            switch (key[0])
+            {
+            case 'd':
+                if (key == "dictionary") { reflect::encoding::json::Deserializer::read(reader, type.dictionary); continue; }
+                break;
+            }
+            break;
+        }
+        reader.skipValue();
+    }
+}
+
+std::string reflect::Type<Foo>::to_json(const Foo& type, const std::string& offset)
+{
+    std::string json;
+    reflect::encoding::json::Writer writer(json, false, offset);
+    to_json(writer, type);
+    return json;
+}
+
+void reflect::Type<Foo>::to_json(reflect::encoding::json::Writer& writer, const Foo& type)
+{
+    writer.beginObject();
+    writer.key("type_id"); writer.value("Foo");
+    writer.key("m_int"); reflect::encoding::json::Serializer::write(writer, type.m_int);
+    writer.key("m_bool"); reflect::encoding::json::Serializer::write(writer, type.m_bool);
+    writer.key("m_string"); reflect::encoding::json::Serializer::write(writer, type.m_string);
+    writer.key("list"); reflect::encoding::json::Serializer::write(writer, type.list);
+    writer.key("dictionary"); reflect::encoding::json::Serializer::write(writer, type.dictionary);
+    writer.key("position"); reflect::Type<math::vec2>::to_json(writer, type.position);
+    writer.endObject();
+}
+
+reflect::type_id_t Foo::type_id() const { return reflect::Type<Foo>::id(); }
+const reflect::meta_t& Foo::type_meta() const { return reflect::Type<Foo>::meta(); }
+const char* const Foo::type_name() const { return reflect::Type<Foo>::name(); }
+const reflect::properties_t& Foo::type_properties() const { return reflect::Type<Foo>::properties(); }
+Foo::operator std::string() const { return reflect::Type<Foo>::to_string(*this); }
+void Foo::from_string(const std::string& str)
+{
+    reflect::Type<Foo>::from_string(str, *this);
+    type_initialize();
+}
+void Foo::from_bytes(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Foo>::read(stream, *this);
+    type_initialize();
+}
+void Foo::from_bytes_body(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Foo>::read_body(stream, *this);
+    type_initialize();
+}
+void Foo::to_bytes(reflect::encoding::OutputByteStream& stream) const { reflect::Type<Foo>::write(stream, *this); }
+std::size_t Foo::binary_size(const reflect::encoding::ByteFormat& format) const { return reflect::Type<Foo>::binary_size(*this, format); }
+void Foo::from_json(const std::string& json)
+{
+    reflect::Type<Foo>::from_json(json, *this);
+    type_initialize();
+}
+void Foo::from_json(reflect::encoding::json::Reader& reader)
+{
+    reflect::Type<Foo>::read_json(reader, *this);
+    type_initialize();
+}
+std::string Foo::to_json(const std::string& offset) const { return reflect::Type<Foo>::to_json(*this, offset); }
+void Foo::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<Foo>::to_json(writer, *this); }
+
+IType* const reflect::Type<Poo>::instantiate()
+{
+    return dynamic_cast<IType*>(new Poo());
+}
+
+std::shared_ptr<IType> reflect::Type<Poo>::instantiate_shared(std::pmr::memory_resource* const resource)
+{
+    if (resource == nullptr) return std::make_shared<Poo>();
+    return std::allocate_shared<Poo>(std::pmr::polymorphic_allocator<Poo>(resource));
+}
+
+const reflect::meta_t& reflect::Type<Poo>::meta()
+{
+    static reflect::meta_t s_meta {
+    };
+    return s_meta;
+}
+reflect::type_id_t reflect::Type<Poo>::id() { return 0x8da37719f40686fdull; }
+std::uint64_t reflect::Type<Poo>::schema() { return 0x68e2b06634c20e43ull; }
+const char* const reflect::Type<Poo>::name() { return "Poo"; }
+
+const reflect::properties_t& Type<Poo>::properties()
+{
+    static reflect::properties_t s_properties {
+        // Parent class Foo properties
+        { "m_int", reflect::Property{ offsetof(Poo, m_int), reflect::meta_t {{"JsonExport", "true"} }, "m_int", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
+        { "m_enum", reflect::Property{ offsetof(Poo, m_enum), reflect::meta_t { }, "m_enum", reflect::PropertyType{ "TestEnum", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(TestEnum), reflect::PropertyType::Type::T_unknown } } },
+        { "m_bool", reflect::Property{ offsetof(Poo, m_bool), reflect::meta_t { }, "m_bool", reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool } } },
+        { "m_string", reflect::Property{ offsetof(Poo, m_string), reflect::meta_t { }, "m_string", reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string } } },
+        { "list", reflect::Property{ offsetof(Poo, list), reflect::meta_t { }, "list", reflect::PropertyType{ "std::list<int>", { 
+            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::list<int>), reflect::PropertyType::Type::T_template } } },
+        { "dictionary", reflect::Property{ offsetof(Poo, dictionary), reflect::meta_t { }, "dictionary", reflect::PropertyType{ "std::map<std::string, int>", { 
+            reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string },
+            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::map<std::string, int>), reflect::PropertyType::Type::T_template } } },
+        { "position", reflect::Property{ offsetof(Poo, position), reflect::meta_t { }, "position", reflect::PropertyType{ "math::vec2", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(math::vec2), reflect::PropertyType::Type::T_native } } },
+        // Properties
+        { "c", reflect::Property{ offsetof(Poo, c), reflect::meta_t { }, "c", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
+        { "tuple", reflect::Property{ offsetof(Poo, tuple), reflect::meta_t { }, "tuple", reflect::PropertyType{ "std::tuple<int, float, bool, double>", { 
+            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
+            reflect::PropertyType{ "float", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(float), reflect::PropertyType::Type::T_float },
+            reflect::PropertyType{ "bool", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(bool), reflect::PropertyType::Type::T_bool },
+            reflect::PropertyType{ "double", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(double), reflect::PropertyType::Type::T_double },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::tuple<int, float, bool, double>), reflect::PropertyType::Type::T_template } } },
+        { "power_dictionary", reflect::Property{ offsetof(Poo, power_dictionary), reflect::meta_t { }, "power_dictionary", reflect::PropertyType{ "std::map<std::string, std::vector<int>>", { 
+            reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string },
+            reflect::PropertyType{ "std::vector<int>", { 
+                reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
+            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<int>), reflect::PropertyType::Type::T_template },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::map<std::string, std::vector<int>>), reflect::PropertyType::Type::T_template } } },
+        { "samples", reflect::Property{ offsetof(Poo, samples), reflect::meta_t { }, "samples", reflect::PropertyType{ "std::vector<float>", { 
+            reflect::PropertyType{ "float", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(float), reflect::PropertyType::Type::T_float },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<float>), reflect::PropertyType::Type::T_template } } },
+        { "shared_foos", reflect::Property{ offsetof(Poo, shared_foos), reflect::meta_t { }, "shared_foos", reflect::PropertyType{ "std::vector<std::shared_ptr<Foo>>", { 
+            reflect::PropertyType{ "std::shared_ptr<Foo>", { 
+                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::shared_ptr<Foo>), reflect::PropertyType::Type::T_template },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::shared_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
+        { "unique_foos", reflect::Property{ offsetof(Poo, unique_foos), reflect::meta_t { }, "unique_foos", reflect::PropertyType{ "std::vector<std::unique_ptr<Foo>>", { 
+            reflect::PropertyType{ "std::unique_ptr<Foo>", { 
+                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::unique_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
+        { "type", reflect::Property{ offsetof(Poo, type), reflect::meta_t { }, "type", reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type } } },
+        { "foos", reflect::Property{ offsetof(Poo, foos), reflect::meta_t { }, "foos", reflect::PropertyType{ "std::vector<Foo>", { 
+            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<Foo>), reflect::PropertyType::Type::T_template } } },
+        { "s_type", reflect::Property{ offsetof(Poo, s_type), reflect::meta_t { }, "s_type", reflect::PropertyType{ "std::shared_ptr<Foo>", { 
+            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::shared_ptr<Foo>), reflect::PropertyType::Type::T_template } } },
+        { "u_type", reflect::Property{ offsetof(Poo, u_type), reflect::meta_t { }, "u_type", reflect::PropertyType{ "std::unique_ptr<Foo>", { 
+            reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template } } },
+    };
+    return s_properties;
+}
+
+std::size_t reflect::Type<Poo>::size()
+{
+    return sizeof(Poo);
+}
+
+void reflect::Type<Poo>::from_string(const std::string& str, Poo& type, const reflect::encoding::ByteFormat& format)
+{
+    from_bytes(str, type, format);
+}
+
+void reflect::Type<Poo>::from_bytes(const reflect::encoding::ByteView& view, Poo& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::InputByteStream stream(view, format);
+    read(stream, type);
+}
+
+void reflect::Type<Poo>::read(reflect::encoding::InputByteStream& stream, Poo& type)
+{
+    reflect::type_id_t _id{ 0 };
+    stream.readFixed(_id);
+    if (_id != id()) return;
+    read_body(stream, type);
+}
+
+void reflect::Type<Poo>::read_body(reflect::encoding::InputByteStream& stream, Poo& type)
+{
+    if (stream.getFormat().tagged)
+    {
+        std::uint64_t _schema{ 0 };
+        std::size_t _fields{ 0 };
+        stream.readFixed(_schema);
+        stream >> _fields;
+        // the writer had a different schema, match the fields by tag and skip the unknown ones
+        if (_schema != schema())
+        {
+            for (std::size_t _i = 0; _i < _fields; ++_i)
+            {
+                std::uint32_t _tag{ 0 };
+                const std::size_t field = stream.beginField(_tag);
+                read_field(stream, type, _tag);
+                stream.endField(field);
+            }
+            return;
+        }
+    }
+    
+    // Parent class Foo properties
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.m_int;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.m_bool;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.m_string;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::Type<math::vec2>::read(stream, type.position);
+            stream.endBlock(end);
+        }
+        stream.endField(field);
+    }
+    // Properties
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.c;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            std::size_t size{ 0 };
+            stream >> size;
+            type.samples.resize(stream.clampArray<float>(size));
+            stream.readArray(type.samples.data(), type.samples.size());
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.shared_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.shared_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.shared_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.shared_foos[i];
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::shared_ptr<Foo> element;
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                    type.shared_foos.push_back(std::move(element));
+                }
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.unique_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.unique_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.unique_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.unique_foos[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.unique_foos.push_back(std::move(element));
+                }
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            const std::size_t end = stream.beginBlock();
+            type.type.from_bytes(stream);
+            stream.endBlock(end);
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                Foo element;
+                {
+                    const std::size_t end = stream.beginBlock();
+                    element.from_bytes(stream);
+                    stream.endBlock(end);
+                }
+                type.foos.push_back(std::move(element));
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        if (stream.readShared(type.s_type))
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::type_id_t type_id{ 0 };
+            stream.readFixed(type_id);
+            if (type_id == Type<Foo>::id())
+            {
+                type.s_type = stream.makeShared<Foo>();
+            }
+            else
+            {
+                type.s_type = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+            }
+            stream.addShared(type.s_type);
+            if (type.s_type) type.s_type->from_bytes_body(stream);
+            stream.endBlock(end);
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        {
+            bool valid = false;
+            stream >> valid;
+            if (valid)
+            {
+                const std::size_t end = stream.beginBlock();
+                reflect::type_id_t type_id{ 0 };
+                stream.readFixed(type_id);
+                if (type_id == Type<Foo>::id())
+                {
+                    type.u_type = std::make_unique<Foo>();
+                }
+                else
+                {
+                    type.u_type = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                }
+                if (type.u_type) type.u_type->from_bytes_body(stream);
+                stream.endBlock(end);
+            }
+        }
+        stream.endField(field);
+    }
+}
+
+void reflect::Type<Poo>::read_field(reflect::encoding::InputByteStream& stream, Poo& type, const std::uint32_t tag)
+{
+    switch (tag)
+    {
+    case 0xb46c42fdu:
+    {
+        stream >> type.m_int;
+        break;
+    }
+    case 0x8d7eff10u:
+    {
+        stream >> type.m_bool;
+        break;
+    }
+    case 0x8902e2b3u:
+    {
+        stream >> type.m_string;
+        break;
+    }
+    case 0xd6031becu:
+    {
+        {
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
+            }
+        }
+        break;
+    }
+    case 0x4a2becc8u:
+    {
+        {
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
+            }
+        }
+        break;
+    }
+    case 0xb01eed6cu:
+    {
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::Type<math::vec2>::read(stream, type.position);
+            stream.endBlock(end);
+        }
+        break;
+    }
+    case 0x296231beu:
+    {
+        stream >> type.c;
+        break;
+    }
+    case 0xd8f917b6u:
+    {
+        {
+            std::size_t size{ 0 };
+            stream >> size;
+            type.samples.resize(stream.clampArray<float>(size));
+            stream.readArray(type.samples.data(), type.samples.size());
+        }
+        break;
+    }
+    case 0x3555fb2fu:
+    {
+        {
+            type.shared_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.shared_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.shared_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.shared_foos[i];
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::shared_ptr<Foo> element;
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                    type.shared_foos.push_back(std::move(element));
+                }
+            }
+        }
+        break;
+    }
+    case 0xebc406d8u:
+    {
+        {
+            type.unique_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.unique_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.unique_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.unique_foos[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.unique_foos.push_back(std::move(element));
+                }
+            }
+        }
+        break;
+    }
+    case 0xdc6ea5c2u:
+    {
+        {
+            const std::size_t end = stream.beginBlock();
+            type.type.from_bytes(stream);
+            stream.endBlock(end);
+        }
+        break;
+    }
+    case 0xd13508b5u:
+    {
+        {
+            type.foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                Foo element;
+                {
+                    const std::size_t end = stream.beginBlock();
+                    element.from_bytes(stream);
+                    stream.endBlock(end);
+                }
+                type.foos.push_back(std::move(element));
+            }
+        }
+        break;
+    }
+    case 0x41a7caa8u:
+    {
+        if (stream.readShared(type.s_type))
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::type_id_t type_id{ 0 };
+            stream.readFixed(type_id);
+            if (type_id == Type<Foo>::id())
+            {
+                type.s_type = stream.makeShared<Foo>();
+            }
+            else
+            {
+                type.s_type = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+            }
+            stream.addShared(type.s_type);
+            if (type.s_type) type.s_type->from_bytes_body(stream);
+            stream.endBlock(end);
+        }
+        break;
+    }
+    case 0xf4f77838u:
+    {
+        {
+            bool valid = false;
+            stream >> valid;
+            if (valid)
+            {
+                const std::size_t end = stream.beginBlock();
+                reflect::type_id_t type_id{ 0 };
+                stream.readFixed(type_id);
+                if (type_id == Type<Foo>::id())
+                {
+                    type.u_type = std::make_unique<Foo>();
+                }
+                else
+                {
+                    type.u_type = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                }
+                if (type.u_type) type.u_type->from_bytes_body(stream);
+                stream.endBlock(end);
+            }
+        }
+        break;
+    }
+    default: break;
+    }
+}
+
+std::string reflect::Type<Poo>::to_string(const Poo& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::OutputByteStream stream(buffer, format);
+    stream.reserve(binary_size(type, format));
+    write(stream, type);
+    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
+}
+
+void reflect::Type<Poo>::write(reflect::encoding::OutputByteStream& stream, const Poo& type)
+{
+    stream.writeFixed(id());
+    if (stream.getFormat().tagged)
+    {
+        stream.writeFixed(schema());
+        stream << std::size_t{ 14 };
+    }
+    
+    // Parent class Foo properties
+    {
+        const std::size_t field = stream.beginField(0xb46c42fdu);
+        stream << type.m_int;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x8d7eff10u);
+        stream << type.m_bool;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x8902e2b3u);
+        stream << type.m_string;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xd6031becu);
+        {
+            stream << type.list.size();
+            for (const auto& element : type.list)
+            {
+                stream << element;
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x4a2becc8u);
+        {
+            stream << type.dictionary.size();
+            for (const auto& pair : type.dictionary)
+            {
+                stream << pair.first;
+                stream << pair.second;
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xb01eed6cu);
+        stream.writeBlock(type.position);
+        stream.endField(field);
+    }
+    // Properties
+    {
+        const std::size_t field = stream.beginField(0x296231beu);
+        stream << type.c;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xd8f917b6u);
+        {
+            stream << type.samples.size();
+            stream.writeArray(type.samples.data(), type.samples.size());
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x3555fb2fu);
+        {
+            stream << type.shared_foos.size();
+            for (const auto& element : type.shared_foos)
+            {
+                stream.writeShared(element);
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xebc406d8u);
+        {
+            stream << type.unique_foos.size();
+            for (const auto& element : type.unique_foos)
+            {
+                stream << (element ? true : false); 
+                if (element) stream.writeBlock(*element);
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xdc6ea5c2u);
+        stream.writeBlock(type.type);
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xd13508b5u);
+        {
+            stream << type.foos.size();
+            for (const auto& element : type.foos)
+            {
+                stream.writeBlock(element);
+            }
+        }
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x41a7caa8u);
+        stream.writeShared(type.s_type);
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0xf4f77838u);
+        stream << (type.u_type ? true : false); 
+        if (type.u_type) stream.writeBlock(*type.u_type);
+        stream.endField(field);
+    }
+}
+
+std::size_t reflect::Type<Poo>::binary_size(const Poo& type, const reflect::encoding::ByteFormat& format)
+{
+    std::size_t size = sizeof(reflect::type_id_t);
+    if (format.tagged)
+    {
+        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ 14 }, format);
+    }
+    
+    // Parent class Foo properties
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_int, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_bool, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.m_string, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.list.size(), format);
+            for (const auto& element : type.list)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(element, format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.dictionary.size(), format);
+            for (const auto& pair : type.dictionary)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(pair.first, format);
+                size += reflect::encoding::OutputByteStream::sizeOf(pair.second, format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOfBlock(reflect::Type<math::vec2>::binary_size(type.position, format), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    // Properties
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.c, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.samples.size(), format);
+        size += reflect::encoding::OutputByteStream::sizeOfArray(type.samples.data(), type.samples.size(), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.shared_foos.size(), format);
+            for (const auto& element : type.shared_foos)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOfShared(element, format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.unique_foos.size(), format);
+            for (const auto& element : type.unique_foos)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(element ? true : false, format);
+                if (element) size += reflect::encoding::OutputByteStream::sizeOfBlock(element->binary_size(format), format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOfBlock(type.type.binary_size(format), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        {
+            size += reflect::encoding::OutputByteStream::sizeOf(type.foos.size(), format);
+            for (const auto& element : type.foos)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOfBlock(element.binary_size(format), format);
+            }
+        }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOfShared(type.s_type, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.u_type ? true : false, format);
+        if (type.u_type) size += reflect::encoding::OutputByteStream::sizeOfBlock(type.u_type->binary_size(format), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    
+    return size;
+}
+
+bool reflect::Type<Poo>::write_delta(const Poo& baseline, const Poo& type, reflect::encoding::OutputByteStream& stream)
+{
+    std::uint8_t _mask[2] = {};
+    const std::size_t _block = stream.beginBlock();
+    const std::size_t _position = stream.getPosition();
+    stream.writeArray(_mask, 2);
+    if (!(baseline.m_int == type.m_int))
+    {
+        _mask[0] |= 0x1;
+        stream << type.m_int;
+    }
+    if (!(baseline.m_bool == type.m_bool))
+    {
+        _mask[0] |= 0x2;
+        stream << type.m_bool;
+    }
+    if (!(baseline.m_string == type.m_string))
+    {
+        _mask[0] |= 0x4;
+        stream << type.m_string;
+    }
+    if (!(baseline.list == type.list))
+    {
+        _mask[0] |= 0x8;
+        {
+            stream << type.list.size();
+            for (const auto& element : type.list)
+            {
+                stream << element;
+            }
+        }
+    }
+    if (!(baseline.dictionary == type.dictionary))
+    {
+        _mask[0] |= 0x10;
+        {
+            stream << type.dictionary.size();
+            for (const auto& pair : type.dictionary)
+            {
+                stream << pair.first;
+                stream << pair.second;
+            }
+        }
+    }
+    {
+        const std::size_t position = stream.getPosition();
+        if (reflect::Type<math::vec2>::write_delta(baseline.position, type.position, stream)) _mask[0] |= 0x20;
+        else stream.rewind(position);
+    }
+    if (!(baseline.c == type.c))
+    {
+        _mask[0] |= 0x40;
+        stream << type.c;
+    }
+    if (!(baseline.samples == type.samples))
+    {
+        _mask[0] |= 0x80;
+        {
+            stream << type.samples.size();
+            stream.writeArray(type.samples.data(), type.samples.size());
+        }
+    }
+    if (reflect::encoding::Delta::changed(baseline.shared_foos, type.shared_foos, stream))
+    {
+        _mask[1] |= 0x1;
+        {
+            stream << type.shared_foos.size();
+            for (const auto& element : type.shared_foos)
+            {
+                stream.writeShared(element);
+            }
+        }
+    }
+    if (reflect::encoding::Delta::changed(baseline.unique_foos, type.unique_foos, stream))
+    {
+        _mask[1] |= 0x2;
+        {
+            stream << type.unique_foos.size();
+            for (const auto& element : type.unique_foos)
+            {
+                stream << (element ? true : false); 
+                if (element) stream.writeBlock(*element);
+            }
+        }
+    }
+    {
+        const std::size_t position = stream.getPosition();
+        if (reflect::Type<Foo>::write_delta(baseline.type, type.type, stream)) _mask[1] |= 0x4;
+        else stream.rewind(position);
+    }
+    if (reflect::encoding::Delta::changed(baseline.foos, type.foos, stream))
+    {
+        _mask[1] |= 0x8;
+        {
+            stream << type.foos.size();
+            for (const auto& element : type.foos)
+            {
+                stream.writeBlock(element);
+            }
+        }
+    }
+    if (reflect::encoding::Delta::changed(baseline.s_type, type.s_type, stream))
+    {
+        _mask[1] |= 0x10;
+        stream.writeShared(type.s_type);
+    }
+    if (reflect::encoding::Delta::changed(baseline.u_type, type.u_type, stream))
+    {
+        _mask[1] |= 0x20;
+        stream << (type.u_type ? true : false); 
+        if (type.u_type) stream.writeBlock(*type.u_type);
+    }
+    stream.patchBytes(_position, _mask, 2);
+    stream.endBlock(_block);
+    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });
+}
+
+void reflect::Type<Poo>::apply_delta(const Poo& baseline, reflect::encoding::InputByteStream& stream, Poo& type)
+{
+    std::uint8_t _mask[2] = {};
+    const std::size_t _end = stream.beginBlock();
+    stream.readArray(_mask, 2);
+    if (_mask[0] & 0x1)
+    {
+        stream >> type.m_int;
+    }
+    else reflect::encoding::Delta::assign(type.m_int, baseline.m_int);
+    if (_mask[0] & 0x2)
+    {
+        stream >> type.m_bool;
+    }
+    else reflect::encoding::Delta::assign(type.m_bool, baseline.m_bool);
+    if (_mask[0] & 0x4)
+    {
+        stream >> type.m_string;
+    }
+    else reflect::encoding::Delta::assign(type.m_string, baseline.m_string);
+    if (_mask[0] & 0x8)
+    {
+        {
+            type.list.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                int element;
+                stream >> element;
+                type.list.push_back(std::move(element));
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.list, baseline.list);
+    if (_mask[0] & 0x10)
+    {
+        {
+            type.dictionary.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                std::string key;
+                stream >> key;
+                int value;
+                stream >> value;
+                type.dictionary.insert(std::make_pair(key, value));
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.dictionary, baseline.dictionary);
+    if (_mask[0] & 0x20) reflect::Type<math::vec2>::apply_delta(baseline.position, stream, type.position);
+    else reflect::encoding::Delta::assign(type.position, baseline.position);
+    if (_mask[0] & 0x40)
+    {
+        stream >> type.c;
+    }
+    else reflect::encoding::Delta::assign(type.c, baseline.c);
+    if (_mask[0] & 0x80)
+    {
+        {
+            std::size_t size{ 0 };
+            stream >> size;
+            type.samples.resize(stream.clampArray<float>(size));
+            stream.readArray(type.samples.data(), type.samples.size());
+        }
+    }
+    else reflect::encoding::Delta::assign(type.samples, baseline.samples);
+    if (_mask[1] & 0x1)
+    {
+        {
+            type.shared_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.shared_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.shared_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.shared_foos[i];
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::shared_ptr<Foo> element;
+                    if (stream.readShared(element))
+                    {
+                        const std::size_t end = stream.beginBlock();
+                        reflect::type_id_t type_id{ 0 };
+                        stream.readFixed(type_id);
+                        if (type_id == Type<Foo>::id())
+                        {
+                            element = stream.makeShared<Foo>();
+                        }
+                        else
+                        {
+                            element = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+                        }
+                        stream.addShared(element);
+                        if (element) element->from_bytes_body(stream);
+                        stream.endBlock(end);
+                    }
+                    type.shared_foos.push_back(std::move(element));
+                }
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.shared_foos, baseline.shared_foos);
+    if (_mask[1] & 0x2)
+    {
+        {
+            type.unique_foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.unique_foos.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.unique_foos.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.unique_foos[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.unique_foos.push_back(std::move(element));
+                }
+            }
+        }
+    }
+    if (_mask[1] & 0x4) reflect::Type<Foo>::apply_delta(baseline.type, stream, type.type);
+    else reflect::encoding::Delta::assign(type.type, baseline.type);
+    if (_mask[1] & 0x8)
+    {
+        {
+            type.foos.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            for (int i = 0; i < size; ++i)
+            {
+                Foo element;
+                {
+                    const std::size_t end = stream.beginBlock();
+                    element.from_bytes(stream);
+                    stream.endBlock(end);
+                }
+                type.foos.push_back(std::move(element));
+            }
+        }
+    }
+    else reflect::encoding::Delta::assign(type.foos, baseline.foos);
+    if (_mask[1] & 0x10)
+    {
+        if (stream.readShared(type.s_type))
+        {
+            const std::size_t end = stream.beginBlock();
+            reflect::type_id_t type_id{ 0 };
+            stream.readFixed(type_id);
+            if (type_id == Type<Foo>::id())
+            {
+                type.s_type = stream.makeShared<Foo>();
+            }
+            else
+            {
+                type.s_type = TypeFactory::instantiate_shared<Foo>(type_id, stream.getResource());
+            }
+            stream.addShared(type.s_type);
+            if (type.s_type) type.s_type->from_bytes_body(stream);
+            stream.endBlock(end);
+        }
+    }
+    else reflect::encoding::Delta::assign(type.s_type, baseline.s_type);
+    if (_mask[1] & 0x20)
+    {
+        {
+            bool valid = false;
+            stream >> valid;
+            if (valid)
+            {
+                const std::size_t end = stream.beginBlock();
+                reflect::type_id_t type_id{ 0 };
+                stream.readFixed(type_id);
+                if (type_id == Type<Foo>::id())
+                {
+                    type.u_type = std::make_unique<Foo>();
+                }
+                else
+                {
+                    type.u_type = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                }
+                if (type.u_type) type.u_type->from_bytes_body(stream);
+                stream.endBlock(end);
+            }
+        }
+    }
+    stream.endBlock(_end);
+}
+
+reflect::encoding::ByteBuffer reflect::Type<Poo>::to_flat(const Poo& type)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::FlatBuilder builder(buffer);
+    builder.finish(write_flat(builder, type));
+    return buffer;
+}
+
+std::size_t reflect::Type<Poo>::write_flat(reflect::encoding::FlatBuilder& builder, const Poo& type)
+{
+    const std::size_t table = builder.beginTable(14);
+    builder.addScalar(table, 0, type.m_int);
+    builder.addScalar(table, 1, type.m_bool);
+    builder.addString(table, 2, type.m_string);
+    builder.setSlot(table, 5, reflect::Type<math::vec2>::write_flat(builder, type.position));
+    builder.addScalar(table, 6, type.c);
+    builder.addArray(table, 7, type.samples.data(), type.samples.size());
+    builder.setSlot(table, 10, reflect::Type<Foo>::write_flat(builder, type.type));
+    {
+        const std::size_t array = builder.beginTableArray(table, 11, type.foos.size());
+        for (std::size_t i = 0; i < type.foos.size(); ++i)
+        {
+            builder.setElement(array, i, reflect::Type<Foo>::write_flat(builder, type.foos[i]));
+        }
+    }
+    return table;
+}
+
+int reflect::Type<Poo>::Flat::m_int() const
+{
+    return m_table.scalar<int>(0);
+}
+bool reflect::Type<Poo>::Flat::m_bool() const
+{
+    return m_table.scalar<bool>(1);
+}
+std::string_view reflect::Type<Poo>::Flat::m_string() const
+{
+    return m_table.string(2);
+}
+reflect::encoding::FlatTable reflect::Type<Poo>::Flat::position() const
+{
+    return m_table.table(5);
+}
+int reflect::Type<Poo>::Flat::c() const
+{
+    return m_table.scalar<int>(6);
+}
+reflect::encoding::FlatArray<float> reflect::Type<Poo>::Flat::samples() const
+{
+    return m_table.array<float>(7);
+}
+reflect::encoding::FlatTable reflect::Type<Poo>::Flat::type() const
+{
+    return m_table.table(10);
+}
+reflect::encoding::FlatArray<reflect::encoding::FlatTable> reflect::Type<Poo>::Flat::foos() const
+{
+    return m_table.array<reflect::encoding::FlatTable>(11);
+}
+
+void reflect::Type<Poo>::from_json(const std::string& json, Poo& type)
+{
+    reflect::encoding::json::Reader reader(json);
+    read_json(reader, type);
+}
+
+void reflect::Type<Poo>::read_json(reflect::encoding::json::Reader& reader, Poo& type)
+{
+    if (!reader.beginObject())
+    {
+        reader.skipValue();
+        return;
+    }
+
+    std::string_view key;
+    while (reader.nextKey(key))
+    {
+        switch (key.size())
+        {
+        case 1:
+            switch (key[0])
+            {
+            case 'c':
+                if (key == "c") { reflect::encoding::json::Deserializer::read(reader, type.c); continue; }
+                break;
+            }
+            break;
+        case 4:
+            switch (key[0])
+            {
+            case 'f':
+                if (key == "foos") { reflect::encoding::json::Deserializer::read(reader, type.foos); continue; }
+                break;
+            case 'l':
+                if (key == "list") { reflect::encoding::json::Deserializer::read(reader, type.list); continue; }
+                break;
+            case 't':
+                if (key == "type") { type.type.from_json(reader); continue; }
+                break;
+            }
+            break;
+        case 5:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_int") { reflect::encoding::json::Deserializer::read(reader, type.m_int); continue; }
+                break;
+            }
+            break;
+        case 6:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_bool") { reflect::encoding::json::Deserializer::read(reader, type.m_bool); continue; }
+                break;
+            case 's':
+                if (key == "s_type") { reflect::encoding::json::Deserializer::read(reader, type.s_type); continue; }
+                break;
+            case 'u':
+                if (key == "u_type") { reflect::encoding::json::Deserializer::read(reader, type.u_type); continue; }
+                break;
+            }
+            break;
+        case 7:
+            switch (key[0])
+            {
+            case 's':
+                if (key == "samples") { reflect::encoding::json::Deserializer::read(reader, type.samples); continue; }
+                break;
+            }
+            break;
+        case 8:
+            switch (key[0])
+            {
+            case 'm':
+                if (key == "m_string") { reflect::encoding::json::Deserializer::read(reader, type.m_string); continue; }
+                break;
+            case 'p':
+                if (key == "position") { reflect::Type<math::vec2>::read_json(reader, type.position); continue; }
+                break;
+            }
+            break;
+        case 10:
+            switch (key[0])
+            {
+            case 'd':
+                if (key == "dictionary") { reflect::encoding::json::Deserializer::read(reader, type.dictionary); continue; }
+                break;
+            }
+            break;
+        case 11:
+            switch (key[0])
+            {
+            case 's':
+                if (key == "shared_foos") { reflect::encoding::json::Deserializer::read(reader, type.shared_foos); continue; }
+                break;
+            case 'u':
+                if (key == "unique_foos") { reflect::encoding::json::Deserializer::read(reader, type.unique_foos); continue; }
+                break;
+            }
+            break;
+        }
+        reader.skipValue();
+    }
+}
+
+std::string reflect::Type<Poo>::to_json(const Poo& type, const std::string& offset)
+{
+    std::string json;
+    reflect::encoding::json::Writer writer(json, false, offset);
+    to_json(writer, type);
+    return json;
+}
+
+void reflect::Type<Poo>::to_json(reflect::encoding::json::Writer& writer, const Poo& type)
+{
+    writer.beginObject();
+    writer.key("type_id"); writer.value("Poo");
+    // Parent class Foo properties
+    writer.key("m_int"); reflect::encoding::json::Serializer::write(writer, type.m_int);
+    writer.key("m_bool"); reflect::encoding::json::Serializer::write(writer, type.m_bool);
+    writer.key("m_string"); reflect::encoding::json::Serializer::write(writer, type.m_string);
+    writer.key("list"); reflect::encoding::json::Serializer::write(writer, type.list);
+    writer.key("dictionary"); reflect::encoding::json::Serializer::write(writer, type.dictionary);
+    writer.key("position"); reflect::Type<math::vec2>::to_json(writer, type.position);
+    // Properties
+    writer.key("c"); reflect::encoding::json::Serializer::write(writer, type.c);
+    writer.key("samples"); reflect::encoding::json::Serializer::write(writer, type.samples);
+    writer.key("shared_foos"); reflect::encoding::json::Serializer::write(writer, type.shared_foos);
+    writer.key("unique_foos"); reflect::encoding::json::Serializer::write(writer, type.unique_foos);
+    writer.key("type"); type.type.to_json(writer);
+    writer.key("foos"); reflect::encoding::json::Serializer::write(writer, type.foos);
+    writer.key("s_type"); reflect::encoding::json::Serializer::write(writer, type.s_type);
+    writer.key("u_type"); reflect::encoding::json::Serializer::write(writer, type.u_type);
+    writer.endObject();
+}
+
+reflect::type_id_t Poo::type_id() const { return reflect::Type<Poo>::id(); }
+const reflect::meta_t& Poo::type_meta() const { return reflect::Type<Poo>::meta(); }
+const char* const Poo::type_name() const { return reflect::Type<Poo>::name(); }
+const reflect::properties_t& Poo::type_properties() const { return reflect::Type<Poo>::properties(); }
+Poo::operator std::string() const { return reflect::Type<Poo>::to_string(*this); }
+void Poo::from_string(const std::string& str)
+{
+    reflect::Type<Poo>::from_string(str, *this);
+    type_initialize();
+}
+void Poo::from_bytes(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Poo>::read(stream, *this);
+    type_initialize();
+}
+void Poo::from_bytes_body(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Poo>::read_body(stream, *this);
+    type_initialize();
+}
+void Poo::to_bytes(reflect::encoding::OutputByteStream& stream) const { reflect::Type<Poo>::write(stream, *this); }
+std::size_t Poo::binary_size(const reflect::encoding::ByteFormat& format) const { return reflect::Type<Poo>::binary_size(*this, format); }
+void Poo::from_json(const std::string& json)
+{
+    reflect::Type<Poo>::from_json(json, *this);
+    type_initialize();
+}
+void Poo::from_json(reflect::encoding::json::Reader& reader)
+{
+    reflect::Type<Poo>::read_json(reader, *this);
+    type_initialize();
+}
+std::string Poo::to_json(const std::string& offset) const { return reflect::Type<Poo>::to_json(*this, offset); }
+void Poo::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<Poo>::to_json(writer, *this); }
+
+IType* const reflect::Type<Too>::instantiate()
+{
+    return dynamic_cast<IType*>(new Too());
+}
+
+std::shared_ptr<IType> reflect::Type<Too>::instantiate_shared(std::pmr::memory_resource* const resource)
+{
+    if (resource == nullptr) return std::make_shared<Too>();
+    return std::allocate_shared<Too>(std::pmr::polymorphic_allocator<Too>(resource));
+}
+
+const reflect::meta_t& reflect::Type<Too>::meta()
+{
+    static reflect::meta_t s_meta {
+    };
+    return s_meta;
+}
+reflect::type_id_t reflect::Type<Too>::id() { return 0x6d02d319e21ea551ull; }
+std::uint64_t reflect::Type<Too>::schema() { return 0xfce836588b4900b4ull; }
+const char* const reflect::Type<Too>::name() { return "Too"; }
+
+const reflect::properties_t& Type<Too>::properties()
+{
+    static reflect::properties_t s_properties {
+        { "types", reflect::Property{ offsetof(Too, types), reflect::meta_t { }, "types", reflect::PropertyType{ "std::vector<std::unique_ptr<Foo>>", { 
+            reflect::PropertyType{ "std::unique_ptr<Foo>", { 
+                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
+            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::unique_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
+    };
+    return s_properties;
+}
+
+std::size_t reflect::Type<Too>::size()
+{
+    return sizeof(Too);
+}
+
+void reflect::Type<Too>::from_string(const std::string& str, Too& type, const reflect::encoding::ByteFormat& format)
+{
+    from_bytes(str, type, format);
+}
+
+void reflect::Type<Too>::from_bytes(const reflect::encoding::ByteView& view, Too& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::InputByteStream stream(view, format);
+    read(stream, type);
+}
+
+void reflect::Type<Too>::read(reflect::encoding::InputByteStream& stream, Too& type)
+{
+    reflect::type_id_t _id{ 0 };
+    stream.readFixed(_id);
+    if (_id != id()) return;
+    read_body(stream, type);
+}
+
+void reflect::Type<Too>::read_body(reflect::encoding::InputByteStream& stream, Too& type)
+{
+    if (stream.getFormat().tagged)
+    {
+        std::uint64_t _schema{ 0 };
+        std::size_t _fields{ 0 };
+        stream.readFixed(_schema);
+        stream >> _fields;
+        // the writer had a different schema, match the fields by tag and skip the unknown ones
+        if (_schema != schema())
+        {
+            for (std::size_t _i = 0; _i < _fields; ++_i)
+            {
+                std::uint32_t _tag{ 0 };
+                const std::size_t field = stream.beginField(_tag);
+                read_field(stream, type, _tag);
+                stream.endField(field);
+            }
+            return;
+        }
+    }
+    
+    {
+        const std::size_t field = stream.beginField();
+        {
+            type.types.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.types.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.types.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.types[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.types.push_back(std::move(element));
+                }
+            }
+        }
+        stream.endField(field);
+    }
+}
+
+void reflect::Type<Too>::read_field(reflect::encoding::InputByteStream& stream, Too& type, const std::uint32_t tag)
+{
+    switch (tag)
+    {
+    case 0x11ad7c55u:
+    {
+        {
+            type.types.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.types.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.types.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.types[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.types.push_back(std::move(element));
+                }
+            }
+        }
+        break;
+    }
+    default: break;
+    }
+}
+
+std::string reflect::Type<Too>::to_string(const Too& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::OutputByteStream stream(buffer, format);
+    stream.reserve(binary_size(type, format));
+    write(stream, type);
+    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
+}
+
+void reflect::Type<Too>::write(reflect::encoding::OutputByteStream& stream, const Too& type)
+{
+    stream.writeFixed(id());
+    if (stream.getFormat().tagged)
+    {
+        stream.writeFixed(schema());
+        stream << std::size_t{ 1 };
+    }
+    
+    {
+        const std::size_t field = stream.beginField(0x11ad7c55u);
+        {
+            stream << type.types.size();
+            for (const auto& element : type.types)
+            {
+                stream << (element ? true : false); 
+                if (element) stream.writeBlock(*element);
+            }
+        }
+        stream.endField(field);
     }
 }
 
-std::string reflect::Type<Poo>::to_string(const Poo& type)
+std::size_t reflect::Type<Too>::binary_size(const Too& type, const reflect::encoding::ByteFormat& format)
 {
-    reflect::encoding::ByteBuffer buffer;
-    reflect::encoding::OutputByteStream stream(buffer);
-    stream << name();
+    std::size_t size = sizeof(reflect::type_id_t);
+    if (format.tagged)
+    {
+        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ 1 }, format);
+    }
     
-    // Parent class Foo properties
-    stream << type.m_int;
-    stream << type.m_bool;
-    stream << type.m_string;
     {
-        stream << type.list.size();
-        for (const auto& element : type.list)
+        const std::size_t field = size;
         {
-            stream << element;
+            size += reflect::encoding::OutputByteStream::sizeOf(type.types.size(), format);
+            for (const auto& element : type.types)
+            {
+                size += reflect::encoding::OutputByteStream::sizeOf(element ? true : false, format);
+                if (element) size += reflect::encoding::OutputByteStream::sizeOfBlock(element->binary_size(format), format);
+            }
         }
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
     }
+    
+    return size;
+}
+
+bool reflect::Type<Too>::write_delta(const Too& baseline, const Too& type, reflect::encoding::OutputByteStream& stream)
+{
+    std::uint8_t _mask[1] = {};
+    const std::size_t _block = stream.beginBlock();
+    const std::size_t _position = stream.getPosition();
+    stream.writeArray(_mask, 1);
+    if (reflect::encoding::Delta::changed(baseline.types, type.types, stream))
     {
-        stream << type.dictionary.size();
-        for (const auto& pair : type.dictionary)
+        _mask[0] |= 0x1;
         {
-            stream << pair.first;
-            stream << pair.second;
+            stream << type.types.size();
+            for (const auto& element : type.types)
+            {
+                stream << (element ? true : false); 
+                if (element) stream.writeBlock(*element);
+            }
         }
     }
-    stream << reflect::Type<math::vec2>::to_string(type.position);
-    // Properties
-    stream << type.c;
+    stream.patchBytes(_position, _mask, 1);
+    stream.endBlock(_block);
+    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });
+}
+
+void reflect::Type<Too>::apply_delta(const Too& baseline, reflect::encoding::InputByteStream& stream, Too& type)
+{
+    std::uint8_t _mask[1] = {};
+    const std::size_t _end = stream.beginBlock();
+    stream.readArray(_mask, 1);
+    static_cast<void>(baseline);
+    if (_mask[0] & 0x1)
     {
-        stream << type.shared_foos.size();
-        for (const auto& element : type.shared_foos)
         {
-            stream << (element ? true : false); 
-            if(element) stream << static_cast<std::string>(*element);
+            type.types.clear();
+            std::size_t size{ 0 };
+            stream >> size;
+            if (stream.isParallel(size))
+            {
+                type.types.resize(stream.clampArray<bool>(size));
+                stream.readParallel(type.types.size(), [&](reflect::encoding::InputByteStream& stream, const std::size_t i)
+                {
+                    auto& element = type.types[i];
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                });
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    std::unique_ptr<Foo> element;
+                    {
+                        bool valid = false;
+                        stream >> valid;
+                        if (valid)
+                        {
+                            const std::size_t end = stream.beginBlock();
+                            reflect::type_id_t type_id{ 0 };
+                            stream.readFixed(type_id);
+                            if (type_id == Type<Foo>::id())
+                            {
+                                element = std::make_unique<Foo>();
+                            }
+                            else
+                            {
+                                element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
+                            }
+                            if (element) element->from_bytes_body(stream);
+                            stream.endBlock(end);
+                        }
+                    }
+                    type.types.push_back(std::move(element));
+                }
+            }
         }
     }
+    stream.endBlock(_end);
+}
+
+reflect::encoding::ByteBuffer reflect::Type<Too>::to_flat(const Too& type)
+{
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::FlatBuilder builder(buffer);
+    builder.finish(write_flat(builder, type));
+    return buffer;
+}
+
+std::size_t reflect::Type<Too>::write_flat(reflect::encoding::FlatBuilder& builder, const Too& type)
+{
+    const std::size_t table = builder.beginTable(1);
+    static_cast<void>(type); // no property has a flat representation
+    return table;
+}
+
+
+void reflect::Type<Too>::from_json(const std::string& json, Too& type)
+{
+    reflect::encoding::json::Reader reader(json);
+    read_json(reader, type);
+}
+
+void reflect::Type<Too>::read_json(reflect::encoding::json::Reader& reader, Too& type)
+{
+    if (!reader.beginObject())
     {
-        stream << type.unique_foos.size();
-        for (const auto& element : type.unique_foos)
-        {
-            stream << (element ? true : false); 
-            if(element) stream << static_cast<std::string>(*element);
-        }
+        reader.skipValue();
+        return;
     }
-    stream << static_cast<std::string>(type.type);
+
+    std::string_view key;
+    while (reader.nextKey(key))
     {
-        stream << type.foos.size();
-        for (const auto& element : type.foos)
+        switch (key.size())
         {
-            stream << static_cast<std::string>(element);
+        case 5:
+            switch (key[0])
+            {
+            case 't':
+                if (key == "types") { reflect::encoding::json::Deserializer::read(reader, type.types); continue; }
+                break;
+            }
+            break;
         }
+        reader.skipValue();
     }
-    stream << (type.s_type ? true : false); 
-    if(type.s_type) stream << static_cast<std::string>(*type.s_type);
-    stream << (type.u_type ? true : false); 
-    if(type.u_type) stream << static_cast<std::string>(*type.u_type);
-    
-    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
 }
 
-void reflect::Type<Poo>::from_json(const std::string& json, Poo& type)
+std::string reflect::Type<Too>::to_json(const Too& type, const std::string& offset)
 {
-    std::string src{ reflect::encoding::json::Deserializer::trim(json, reflect::encoding::json::Deserializer::space) };
-    
-    size_t index = 0;
-    std::string key;
-    while ((index = reflect::encoding::json::Deserializer::next_key(src, key)) != std::string::npos)
-    {
-        src = src.substr(index + 2);
-        src = reflect::encoding::json::Deserializer::ltrim(src, reflect::encoding::json::Deserializer::space);
-        std::string value;
-        index = reflect::encoding::json::Deserializer::next_value(src, value);
-        if (index != std::string::npos)
-        {
-            // Parent class Foo properties
-            if (key == "m_int") reflect::encoding::json::Deserializer::parse(value, type.m_int);
-            if (key == "m_bool") reflect::encoding::json::Deserializer::parse(value, type.m_bool);
-            if (key == "m_string") reflect::encoding::json::Deserializer::parse(value, type.m_string);
-            if (key == "list") reflect::encoding::json::Deserializer::parse(value, type.list);
-            if (key == "dictionary") reflect::encoding::json::Deserializer::parse(value, type.dictionary);
-            if (key == "position") reflect::Type<math::vec2>::from_json(value, type.position);
-            // Properties
-            if (key == "c") reflect::encoding::json::Deserializer::parse(value, type.c);
-            if (key == "shared_foos") reflect::encoding::json::Deserializer::parse(value, type.shared_foos);
-            if (key == "unique_foos") reflect::encoding::json::Deserializer::parse(value, type.unique_foos);
-            if (key == "type") type.type.from_json(value);
-            if (key == "foos") reflect::encoding::json::Deserializer::parse(value, type.foos);
-            if (key == "s_type") reflect::encoding::json::Deserializer::parse(value, type.s_type);
-            if (key == "u_type") reflect::encoding::json::Deserializer::parse(value, type.u_type);
-            src = src.substr(index + 1);
-        }
-        else break;
-    };
+    std::string json;
+    reflect::encoding::json::Writer writer(json, false, offset);
+    to_json(writer, type);
+    return json;
 }
 
-std::string reflect::Type<Poo>::to_json(const Poo& type, const std::string& offset)
+void reflect::Type<Too>::to_json(reflect::encoding::json::Writer& writer, const Too& type)
 {
-    std::stringstream stream;
-    stream << "{" << std::endl;
-    stream << offset << "    " << "\"type_id\": " << "\"Poo\"" << "," << std::endl;
-    // Parent class Foo properties
-    stream << offset << "    " << "\"m_int\": " << reflect::encoding::json::Serializer::to_string(type.m_int) << "," << std::endl;
-    stream << offset << "    " << "\"m_bool\": " << reflect::encoding::json::Serializer::to_string(type.m_bool) << "," << std::endl;
-    stream << offset << "    " << "\"m_string\": " << reflect::encoding::json::Serializer::to_string(type.m_string) << "," << std::endl;
-    stream << offset << "    " << "\"list\": " << reflect::encoding::json::Serializer::to_string(type.list) << "," << std::endl;
-    stream << offset << "    " << "\"dictionary\": " << reflect::encoding::json::Serializer::to_string(type.dictionary) << "," << std::endl;
-    stream << offset << "    " << "\"position\": " << reflect::Type<math::vec2>::to_json(type.position, offset + "    ") << "," << std::endl;
-    // Properties
-    stream << offset << "    " << "\"c\": " << reflect::encoding::json::Serializer::to_string(type.c) << "," << std::endl;
-    stream << offset << "    " << "\"shared_foos\": " << reflect::encoding::json::Serializer::to_string(type.shared_foos) << "," << std::endl;
-    stream << offset << "    " << "\"unique_foos\": " << reflect::encoding::json::Serializer::to_string(type.unique_foos) << "," << std::endl;
-    stream << offset << "    " << "\"type\": " << type.type.to_json(offset + "    ") << "," << std::endl;
-    stream << offset << "    " << "\"foos\": " << reflect::encoding::json::Serializer::to_string(type.foos) << "," << std::endl;
-    stream << offset << "    " << "\"s_type\": " << reflect::encoding::json::Serializer::to_string(type.s_type) << "," << std::endl;
-    stream << offset << "    " << "\"u_type\": " << reflect::encoding::json::Serializer::to_string(type.u_type) << "," << std::endl;
-    stream << offset << "}";
-    return stream.str();
+    writer.beginObject();
+    writer.key("type_id"); writer.value("Too");
+    writer.key("types"); reflect::encoding::json::Serializer::write(writer, type.types);
+    writer.endObject();
 }
 
-const reflect::meta_t& Poo::type_meta() const { return reflect::Type<Poo>::meta(); }
-const char* const Poo::type_name() const { return reflect::Type<Poo>::name(); }
-const reflect::properties_t& Poo::type_properties() const { return reflect::Type<Poo>::properties(); }
-Poo::operator std::string() const { return reflect::Type<Poo>::to_string(*this); }
-void Poo::from_string(const std::string& str)
+reflect::type_id_t Too::type_id() const { return reflect::Type<Too>::id(); }
+const reflect::meta_t& Too::type_meta() const { return reflect::Type<Too>::meta(); }
+const char* const Too::type_name() const { return reflect::Type<Too>::name(); }
+const reflect::properties_t& Too::type_properties() const { return reflect::Type<Too>::properties(); }
+Too::operator std::string() const { return reflect::Type<Too>::to_string(*this); }
+void Too::from_string(const std::string& str)
 {
-    reflect::Type<Poo>::from_string(str, *this);
+    reflect::Type<Too>::from_string(str, *this);
     type_initialize();
 }
-void Poo::from_json(const std::string& json)
+void Too::from_bytes(reflect::encoding::InputByteStream& stream)
 {
-    reflect::Type<Poo>::from_json(json, *this);
+    reflect::Type<Too>::read(stream, *this);
     type_initialize();
 }
-std::string Poo::to_json(const std::string& offset) const { return reflect::Type<Poo>::to_json(*this, offset); }
+void Too::from_bytes_body(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Too>::read_body(stream, *this);
+    type_initialize();
+}
+void Too::to_bytes(reflect::encoding::OutputByteStream& stream) const { reflect::Type<Too>::write(stream, *this); }
+std::size_t Too::binary_size(const reflect::encoding::ByteFormat& format) const { return reflect::Type<Too>::binary_size(*this, format); }
+void Too::from_json(const std::string& json)
+{
+    reflect::Type<Too>::from_json(json, *this);
+    type_initialize();
+}
+void Too::from_json(reflect::encoding::json::Reader& reader)
+{
+    reflect::Type<Too>::read_json(reader, *this);
+    type_initialize();
+}
+std::string Too::to_json(const std::string& offset) const { return reflect::Type<Too>::to_json(*this, offset); }
+void Too::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<Too>::to_json(writer, *this); }
 
-IType* const reflect::Type<Too>::instantiate()
+IType* const reflect::Type<Profile>::instantiate()
 {
-    return dynamic_cast<IType*>(new Too());
+    return dynamic_cast<IType*>(new Profile());
 }
 
-const reflect::meta_t& reflect::Type<Too>::meta()
+std::shared_ptr<IType> reflect::Type<Profile>::instantiate_shared(std::pmr::memory_resource* const resource)
+{
+    if (resource == nullptr) return std::make_shared<Profile>();
+    return std::allocate_shared<Profile>(std::pmr::polymorphic_allocator<Profile>(resource));
+}
+
+const reflect::meta_t& reflect::Type<Profile>::meta()
 {
     static reflect::meta_t s_meta {
+        { "Tracked", "" },
     };
     return s_meta;
 }
-const char* const reflect::Type<Too>::name() { return "Too"; }
+reflect::type_id_t reflect::Type<Profile>::id() { return 0xb061ff5a347a296eull; }
+std::uint64_t reflect::Type<Profile>::schema() { return 0x1c22b8914f672fd9ull; }
+const char* const reflect::Type<Profile>::name() { return "Profile"; }
 
-const reflect::properties_t& Type<Too>::properties()
+const reflect::properties_t& Type<Profile>::properties()
 {
     static reflect::properties_t s_properties {
-        { "types", reflect::Property{ offsetof(Too, types), reflect::meta_t { }, "types", reflect::PropertyType{ "std::vector<std::unique_ptr<Foo>>", { 
-            reflect::PropertyType{ "std::unique_ptr<Foo>", { 
-                reflect::PropertyType{ "Foo", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(Foo), reflect::PropertyType::Type::T_type },
-            }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::unique_ptr<Foo>), reflect::PropertyType::Type::T_template },
-        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<std::unique_ptr<Foo>>), reflect::PropertyType::Type::T_template } } },
+        { "name", reflect::Property{ offsetof(Profile, name), reflect::meta_t { }, "name", reflect::PropertyType{ "std::string", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::string), reflect::PropertyType::Type::T_string } } },
+        { "level", reflect::Property{ offsetof(Profile, level), reflect::meta_t { }, "level", reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int } } },
+        { "items", reflect::Property{ offsetof(Profile, items), reflect::meta_t { }, "items", reflect::PropertyType{ "std::vector<int>", { 
+            reflect::PropertyType{ "int", {  }, reflect::PropertyType::DecoratorType::D_raw, sizeof(int), reflect::PropertyType::Type::T_int },
+        }, reflect::PropertyType::DecoratorType::D_raw, sizeof(std::vector<int>), reflect::PropertyType::Type::T_template } } },
     };
     return s_properties;
 }
 
-std::size_t reflect::Type<Too>::size()
+std::size_t reflect::Type<Profile>::size()
 {
-    return sizeof(Too);
+    return sizeof(Profile);
 }
 
-void reflect::Type<Too>::from_string(const std::string& str, Too& type)
+void reflect::Type<Profile>::from_string(const std::string& str, Profile& type, const reflect::encoding::ByteFormat& format)
 {
-    reflect::encoding::ByteBuffer buffer;
-    std::transform(
-        std::begin(str),
-        std::end(str),
-        std::back_inserter(buffer),
-        [](const char c)
+    from_bytes(str, type, format);
+}
+
+void reflect::Type<Profile>::from_bytes(const reflect::encoding::ByteView& view, Profile& type, const reflect::encoding::ByteFormat& format)
+{
+    reflect::encoding::InputByteStream stream(view, format);
+    read(stream, type);
+}
+
+void reflect::Type<Profile>::read(reflect::encoding::InputByteStream& stream, Profile& type)
+{
+    reflect::type_id_t _id{ 0 };
+    stream.readFixed(_id);
+    if (_id != id()) return;
+    read_body(stream, type);
+}
+
+void reflect::Type<Profile>::read_body(reflect::encoding::InputByteStream& stream, Profile& type)
+{
+    type.invalidate_cache();
+    if (stream.getFormat().tagged)
+    {
+        std::uint64_t _schema{ 0 };
+        std::size_t _fields{ 0 };
+        stream.readFixed(_schema);
+        stream >> _fields;
+        // the writer had a different schema, match the fields by tag and skip the unknown ones
+        if (_schema != schema())
         {
-            return std::byte(c);
+            for (std::size_t _i = 0; _i < _fields; ++_i)
+            {
+                std::uint32_t _tag{ 0 };
+                const std::size_t field = stream.beginField(_tag);
+                read_field(stream, type, _tag);
+                stream.endField(field);
+            }
+            return;
         }
-    );
-    
-    reflect::encoding::InputByteStream stream(buffer);
-    std::string _name;
-    stream >> _name;
-    if (_name != name()) return;
+    }
     
     {
-        type.types.clear();
-        std::size_t size;
-        stream >> size;
-        for (int i = 0; i < size; ++i)
+        const std::size_t field = stream.beginField();
+        stream >> type.name;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
+        stream >> type.level;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField();
         {
-            std::unique_ptr<Foo> element;
-            {
-                bool valid = false;
-                stream >> valid;
-                if (valid)
-                {
-                    reflect::encoding::InputByteStream temp_stream(buffer, stream.getIndex());
-                    std::size_t temp_element_size;
-                    temp_stream >> temp_element_size;
-                    std::string type_id;
-                    temp_stream >> type_id;
-                    if (type_id == Type<Foo>::name())
-                    {
-                        element = std::make_unique<Foo>();
-                    }
-                    else
-                    {
-                        element = std::unique_ptr<Foo>(TypeFactory::instantiate<Foo>(type_id));
-                    }
-                    {
-                        std::string pack;
-                        stream >> pack;
-                        element->from_string(pack);
-                    }
-                }
-            }
-            type.types.push_back(std::move(element));
+            std::size_t size{ 0 };
+            stream >> size;
+            type.items.resize(stream.clampArray<int>(size));
+            stream.readArray(type.items.data(), type.items.size());
+        }
+        stream.endField(field);
+    }
+}
+
+void reflect::Type<Profile>::read_field(reflect::encoding::InputByteStream& stream, Profile& type, const std::uint32_t tag)
+{
+    type.invalidate_cache();
+    switch (tag)
+    {
+    case 0x4adfb63cu:
+    {
+        stream >> type.name;
+        break;
+    }
+    case 0x75a1b997u:
+    {
+        stream >> type.level;
+        break;
+    }
+    case 0x7139a8d0u:
+    {
+        {
+            std::size_t size{ 0 };
+            stream >> size;
+            type.items.resize(stream.clampArray<int>(size));
+            stream.readArray(type.items.data(), type.items.size());
         }
+        break;
+    }
+    default: break;
     }
 }
 
-std::string reflect::Type<Too>::to_string(const Too& type)
+std::string reflect::Type<Profile>::to_string(const Profile& type, const reflect::encoding::ByteFormat& format)
 {
     reflect::encoding::ByteBuffer buffer;
-    reflect::encoding::OutputByteStream stream(buffer);
-    stream << name();
+    reflect::encoding::OutputByteStream stream(buffer, format);
+    stream.reserve(binary_size(type, format));
+    write(stream, type);
+    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
+}
+
+void reflect::Type<Profile>::write(reflect::encoding::OutputByteStream& stream, const Profile& type)
+{
+    stream.writeFixed(id());
+    if (stream.getFormat().tagged)
+    {
+        stream.writeFixed(schema());
+        stream << std::size_t{ 3 };
+    }
     
     {
-        stream << type.types.size();
-        for (const auto& element : type.types)
+        const std::size_t field = stream.beginField(0x4adfb63cu);
+        stream << type.name;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x75a1b997u);
+        stream << type.level;
+        stream.endField(field);
+    }
+    {
+        const std::size_t field = stream.beginField(0x7139a8d0u);
         {
-            stream << (element ? true : false); 
-            if(element) stream << static_cast<std::string>(*element);
+            stream << type.items.size();
+            stream.writeArray(type.items.data(), type.items.size());
         }
+        stream.endField(field);
     }
-    
-    return std::string(reinterpret_cast<const char*>(&stream.getBuffer()[0]), stream.getBuffer().size());
 }
 
-void reflect::Type<Too>::from_json(const std::string& json, Too& type)
+std::size_t reflect::Type<Profile>::binary_size(const Profile& type, const reflect::encoding::ByteFormat& format)
 {
-    std::string src{ reflect::encoding::json::Deserializer::trim(json, reflect::encoding::json::Deserializer::space) };
+    std::size_t size = sizeof(reflect::type_id_t);
+    if (format.tagged)
+    {
+        size += sizeof(std::uint64_t) + reflect::encoding::OutputByteStream::sizeOf(std::size_t{ 3 }, format);
+    }
+    
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.name, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.level, format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
+    {
+        const std::size_t field = size;
+        size += reflect::encoding::OutputByteStream::sizeOf(type.items.size(), format);
+        size += reflect::encoding::OutputByteStream::sizeOfArray(type.items.data(), type.items.size(), format);
+        size += reflect::encoding::OutputByteStream::sizeOfField(size - field, format);
+    }
     
-    size_t index = 0;
-    std::string key;
-    while ((index = reflect::encoding::json::Deserializer::next_key(src, key)) != std::string::npos)
+    return size;
+}
+
+bool reflect::Type<Profile>::write_delta(const Profile& baseline, const Profile& type, reflect::encoding::OutputByteStream& stream)
+{
+    std::uint8_t _mask[1] = {};
+    const std::size_t _block = stream.beginBlock();
+    const std::size_t _position = stream.getPosition();
+    stream.writeArray(_mask, 1);
+    if (!(baseline.name == type.name))
+    {
+        _mask[0] |= 0x1;
+        stream << type.name;
+    }
+    if (!(baseline.level == type.level))
+    {
+        _mask[0] |= 0x2;
+        stream << type.level;
+    }
+    if (!(baseline.items == type.items))
     {
-        src = src.substr(index + 2);
-        src = reflect::encoding::json::Deserializer::ltrim(src, reflect::encoding::json::Deserializer::space);
-        std::string value;
-        index = reflect::encoding::json::Deserializer::next_value(src, value);
-        if (index != std::string::npos)
+        _mask[0] |= 0x4;
         {
-            if (key == "types") reflect::encoding::json::Deserializer::parse(value, type.types);
-            src = src.substr(index + 1);
+            stream << type.items.size();
+            stream.writeArray(type.items.data(), type.items.size());
         }
-        else break;
-    };
+    }
+    stream.patchBytes(_position, _mask, 1);
+    stream.endBlock(_block);
+    return std::any_of(std::begin(_mask), std::end(_mask), [](const std::uint8_t bits) { return bits != 0; });
 }
 
-std::string reflect::Type<Too>::to_json(const Too& type, const std::string& offset)
+void reflect::Type<Profile>::apply_delta(const Profile& baseline, reflect::encoding::InputByteStream& stream, Profile& type)
 {
-    std::stringstream stream;
-    stream << "{" << std::endl;
-    stream << offset << "    " << "\"type_id\": " << "\"Too\"" << "," << std::endl;
-    stream << offset << "    " << "\"types\": " << reflect::encoding::json::Serializer::to_string(type.types) << "," << std::endl;
-    stream << offset << "}";
-    return stream.str();
+    type.invalidate_cache();
+    std::uint8_t _mask[1] = {};
+    const std::size_t _end = stream.beginBlock();
+    stream.readArray(_mask, 1);
+    if (_mask[0] & 0x1)
+    {
+        stream >> type.name;
+    }
+    else reflect::encoding::Delta::assign(type.name, baseline.name);
+    if (_mask[0] & 0x2)
+    {
+        stream >> type.level;
+    }
+    else reflect::encoding::Delta::assign(type.level, baseline.level);
+    if (_mask[0] & 0x4)
+    {
+        {
+            std::size_t size{ 0 };
+            stream >> size;
+            type.items.resize(stream.clampArray<int>(size));
+            stream.readArray(type.items.data(), type.items.size());
+        }
+    }
+    else reflect::encoding::Delta::assign(type.items, baseline.items);
+    stream.endBlock(_end);
 }
 
-const reflect::meta_t& Too::type_meta() const { return reflect::Type<Too>::meta(); }
-const char* const Too::type_name() const { return reflect::Type<Too>::name(); }
-const reflect::properties_t& Too::type_properties() const { return reflect::Type<Too>::properties(); }
-Too::operator std::string() const { return reflect::Type<Too>::to_string(*this); }
-void Too::from_string(const std::string& str)
+reflect::encoding::ByteBuffer reflect::Type<Profile>::to_flat(const Profile& type)
 {
-    reflect::Type<Too>::from_string(str, *this);
+    reflect::encoding::ByteBuffer buffer;
+    reflect::encoding::FlatBuilder builder(buffer);
+    builder.finish(write_flat(builder, type));
+    return buffer;
+}
+
+std::size_t reflect::Type<Profile>::write_flat(reflect::encoding::FlatBuilder& builder, const Profile& type)
+{
+    const std::size_t table = builder.beginTable(3);
+    builder.addString(table, 0, type.name);
+    builder.addScalar(table, 1, type.level);
+    builder.addArray(table, 2, type.items.data(), type.items.size());
+    return table;
+}
+
+std::string_view reflect::Type<Profile>::Flat::name() const
+{
+    return m_table.string(0);
+}
+int reflect::Type<Profile>::Flat::level() const
+{
+    return m_table.scalar<int>(1);
+}
+reflect::encoding::FlatArray<int> reflect::Type<Profile>::Flat::items() const
+{
+    return m_table.array<int>(2);
+}
+
+void reflect::Type<Profile>::from_json(const std::string& json, Profile& type)
+{
+    reflect::encoding::json::Reader reader(json);
+    read_json(reader, type);
+}
+
+void reflect::Type<Profile>::read_json(reflect::encoding::json::Reader& reader, Profile& type)
+{
+    type.invalidate_cache();
+    if (!reader.beginObject())
+    {
+        reader.skipValue();
+        return;
+    }
+
+    std::string_view key;
+    while (reader.nextKey(key))
+    {
+        switch (key.size())
+        {
+        case 4:
+            switch (key[0])
+            {
+            case 'n':
+                if (key == "name") { reflect::encoding::json::Deserializer::read(reader, type.name); continue; }
+                break;
+            }
+            break;
+        case 5:
+            switch (key[0])
+            {
+            case 'i':
+                if (key == "items") { reflect::encoding::json::Deserializer::read(reader, type.items); continue; }
+                break;
+            case 'l':
+                if (key == "level") { reflect::encoding::json::Deserializer::read(reader, type.level); continue; }
+                break;
+            }
+            break;
+        }
+        reader.skipValue();
+    }
+}
+
+std::string reflect::Type<Profile>::to_json(const Profile& type, const std::string& offset)
+{
+    std::string json;
+    reflect::encoding::json::Writer writer(json, false, offset);
+    to_json(writer, type);
+    return json;
+}
+
+void reflect::Type<Profile>::to_json(reflect::encoding::json::Writer& writer, const Profile& type)
+{
+    writer.beginObject();
+    writer.key("type_id"); writer.value("Profile");
+    writer.key("name"); reflect::encoding::json::Serializer::write(writer, type.name);
+    writer.key("level"); reflect::encoding::json::Serializer::write(writer, type.level);
+    writer.key("items"); reflect::encoding::json::Serializer::write(writer, type.items);
+    writer.endObject();
+}
+
+void reflect::Type<Profile>::set_name(Profile& type, std::string value)
+{
+    type.name = std::move(value);
+    type.mark_dirty(Dirty::name);
+}
+
+void reflect::Type<Profile>::set_level(Profile& type, int value)
+{
+    type.level = std::move(value);
+    type.mark_dirty(Dirty::level);
+}
+
+void reflect::Type<Profile>::set_items(Profile& type, std::vector<int> value)
+{
+    type.items = std::move(value);
+    type.mark_dirty(Dirty::items);
+}
+
+reflect::type_id_t Profile::type_id() const { return reflect::Type<Profile>::id(); }
+const reflect::meta_t& Profile::type_meta() const { return reflect::Type<Profile>::meta(); }
+const char* const Profile::type_name() const { return reflect::Type<Profile>::name(); }
+const reflect::properties_t& Profile::type_properties() const { return reflect::Type<Profile>::properties(); }
+Profile::operator std::string() const { return to_string(reflect::encoding::ByteFormat{}); }
+void Profile::from_string(const std::string& str)
+{
+    reflect::Type<Profile>::from_string(str, *this);
     type_initialize();
 }
-void Too::from_json(const std::string& json)
+void Profile::from_bytes(reflect::encoding::InputByteStream& stream)
 {
-    reflect::Type<Too>::from_json(json, *this);
+    reflect::Type<Profile>::read(stream, *this);
+    type_initialize();
+}
+void Profile::from_bytes_body(reflect::encoding::InputByteStream& stream)
+{
+    reflect::Type<Profile>::read_body(stream, *this);
+    type_initialize();
+}
+void Profile::to_bytes(reflect::encoding::OutputByteStream& stream) const
+{
+    write_cached(stream, [this](reflect::encoding::OutputByteStream& cache) { reflect::Type<Profile>::write(cache, *this); });
+}
+std::size_t Profile::binary_size(const reflect::encoding::ByteFormat& format) const
+{
+    return binary_size_cached(format, [this, &format]() { return reflect::Type<Profile>::binary_size(*this, format); });
+}
+void Profile::from_json(const std::string& json)
+{
+    reflect::Type<Profile>::from_json(json, *this);
+    type_initialize();
+}
+void Profile::from_json(reflect::encoding::json::Reader& reader)
+{
+    reflect::Type<Profile>::read_json(reader, *this);
     type_initialize();
 }
-std::string Too::to_json(const std::string& offset) const { return reflect::Type<Too>::to_json(*this, offset); }
\ No newline at end of file
+std::string Profile::to_json(const std::string& offset) const
+{
+    return to_json_cached(offset, [this, &offset]() { return reflect::Type<Profile>::to_json(*this, offset); });
+}
+void Profile::to_json(reflect::encoding::json::Writer& writer) const { reflect::Type<Profile>::to_json(writer, *this); }
\ No newline at end of file
@@ -18,30 +18,93 @@ namespace math { typedef struct vector2_t<float> vec2; }
 template <>
 struct reflect::Type<math::vec2>
 {
+    static reflect::type_id_t id();
+    static std::uint64_t schema();
     static const reflect::meta_t& meta();
     static const char* const name();
     static const reflect::properties_t& properties();
     static std::size_t size();
 
-    static void from_string(const std::string& str, math::vec2& type);
-    static std::string to_string(const math::vec2& type);
+    static void from_string(const std::string& str, math::vec2& type, const reflect::encoding::ByteFormat& format = {});
+    static void from_bytes(const reflect::encoding::ByteView& view, math::vec2& type, const reflect::encoding::ByteFormat& format = {});
+    static void read(reflect::encoding::InputByteStream& stream, math::vec2& type);
+    static void read_body(reflect::encoding::InputByteStream& stream, math::vec2& type);
+    static void read_field(reflect::encoding::InputByteStream& stream, math::vec2& type, const std::uint32_t tag);
+    static std::string to_string(const math::vec2& type, const reflect::encoding::ByteFormat& format = {});
+    static void write(reflect::encoding::OutputByteStream& stream, const math::vec2& type);
+    static std::size_t binary_size(const math::vec2& type, const reflect::encoding::ByteFormat& format = {});
+    static bool write_delta(const math::vec2& baseline, const math::vec2& type, reflect::encoding::OutputByteStream& stream);
+    static void apply_delta(const math::vec2& baseline, reflect::encoding::InputByteStream& stream, math::vec2& type);
     static void from_json(const std::string& json, math::vec2& type);
+    static void read_json(reflect::encoding::json::Reader& reader, math::vec2& type);
     static std::string to_json(const math::vec2& type, const std::string& offset = "");
+    static void to_json(reflect::encoding::json::Writer& writer, const math::vec2& type);
+
+    typedef reflect::encoding::LazyView<math::vec2> LazyView;
+
+    static reflect::encoding::ByteBuffer to_flat(const math::vec2& type);
+    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const math::vec2& type);
+
+    // read-only accessors over a flat buffer
+    struct Flat
+    {
+        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}
+        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}
+
+        bool isValid() const { return m_table.isValid(); }
+        float x() const;
+        float y() const;
+
+        reflect::encoding::FlatTable m_table;
+    };
 };
 
 template <>
 struct reflect::Type<struct Foo> : reflect::RegisteredInTypeFactory<struct Foo>
 {
     static IType* const instantiate();
+    static std::shared_ptr<IType> instantiate_shared(std::pmr::memory_resource* const resource);
+    static reflect::type_id_t id();
+    static std::uint64_t schema();
     static const reflect::meta_t& meta();
     static const char* const name();
     static const reflect::properties_t& properties();
     static std::size_t size();
 
-    static void from_string(const std::string& str, Foo& type);
-    static std::string to_string(const Foo& type);
+    static void from_string(const std::string& str, Foo& type, const reflect::encoding::ByteFormat& format = {});
+    static void from_bytes(const reflect::encoding::ByteView& view, Foo& type, const reflect::encoding::ByteFormat& format = {});
+    static void read(reflect::encoding::InputByteStream& stream, Foo& type);
+    static void read_body(reflect::encoding::InputByteStream& stream, Foo& type);
+    static void read_field(reflect::encoding::InputByteStream& stream, Foo& type, const std::uint32_t tag);
+    static std::string to_string(const Foo& type, const reflect::encoding::ByteFormat& format = {});
+    static void write(reflect::encoding::OutputByteStream& stream, const Foo& type);
+    static std::size_t binary_size(const Foo& type, const reflect::encoding::ByteFormat& format = {});
+    static bool write_delta(const Foo& baseline, const Foo& type, reflect::encoding::OutputByteStream& stream);
+    static void apply_delta(const Foo& baseline, reflect::encoding::InputByteStream& stream, Foo& type);
     static void from_json(const std::string& json, Foo& type);
+    static void read_json(reflect::encoding::json::Reader& reader, Foo& type);
     static std::string to_json(const Foo& type, const std::string& offset = "");
+    static void to_json(reflect::encoding::json::Writer& writer, const Foo& type);
+
+    typedef reflect::encoding::LazyView<Foo> LazyView;
+
+    static reflect::encoding::ByteBuffer to_flat(const Foo& type);
+    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const Foo& type);
+
+    // read-only accessors over a flat buffer
+    struct Flat
+    {
+        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}
+        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}
+
+        bool isValid() const { return m_table.isValid(); }
+        int m_int() const;
+        bool m_bool() const;
+        std::string_view m_string() const;
+        reflect::encoding::FlatTable position() const;
+
+        reflect::encoding::FlatTable m_table;
+    };
 
     static bool registered() { return type_registered; };
 };
@@ -50,15 +113,52 @@ template <>
 struct reflect::Type<struct Poo> : reflect::RegisteredInTypeFactory<struct Poo>
 {
     static IType* const instantiate();
+    static std::shared_ptr<IType> instantiate_shared(std::pmr::memory_resource* const resource);
+    static reflect::type_id_t id();
+    static std::uint64_t schema();
     static const reflect::meta_t& meta();
     static const char* const name();
     static const reflect::properties_t& properties();
     static std::size_t size();
 
-    static void from_string(const std::string& str, Poo& type);
-    static std::string to_string(const Poo& type);
+    static void from_string(const std::string& str, Poo& type, const reflect::encoding::ByteFormat& format = {});
+    static void from_bytes(const reflect::encoding::ByteView& view, Poo& type, const reflect::encoding::ByteFormat& format = {});
+    static void read(reflect::encoding::InputByteStream& stream, Poo& type);
+    static void read_body(reflect::encoding::InputByteStream& stream, Poo& type);
+    static void read_field(reflect::encoding::InputByteStream& stream, Poo& type, const std::uint32_t tag);
+    static std::string to_string(const Poo& type, const reflect::encoding::ByteFormat& format = {});
+    static void write(reflect::encoding::OutputByteStream& stream, const Poo& type);
+    static std::size_t binary_size(const Poo& type, const reflect::encoding::ByteFormat& format = {});
+    static bool write_delta(const Poo& baseline, const Poo& type, reflect::encoding::OutputByteStream& stream);
+    static void apply_delta(const Poo& baseline, reflect::encoding::InputByteStream& stream, Poo& type);
     static void from_json(const std::string& json, Poo& type);
+    static void read_json(reflect::encoding::json::Reader& reader, Poo& type);
     static std::string to_json(const Poo& type, const std::string& offset = "");
+    static void to_json(reflect::encoding::json::Writer& writer, const Poo& type);
+
+    typedef reflect::encoding::LazyView<Poo> LazyView;
+
+    static reflect::encoding::ByteBuffer to_flat(const Poo& type);
+    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const Poo& type);
+
+    // read-only accessors over a flat buffer
+    struct Flat
+    {
+        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}
+        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}
+
+        bool isValid() const { return m_table.isValid(); }
+        int m_int() const;
+        bool m_bool() const;
+        std::string_view m_string() const;
+        reflect::encoding::FlatTable position() const;
+        int c() const;
+        reflect::encoding::FlatArray<float> samples() const;
+        reflect::encoding::FlatTable type() const;
+        reflect::encoding::FlatArray<reflect::encoding::FlatTable> foos() const;
+
+        reflect::encoding::FlatTable m_table;
+    };
 
     static bool registered() { return type_registered; };
 };
@@ -67,15 +167,105 @@ template <>
 struct reflect::Type<struct Too> : reflect::RegisteredInTypeFactory<struct Too>
 {
     static IType* const instantiate();
+    static std::shared_ptr<IType> instantiate_shared(std::pmr::memory_resource* const resource);
+    static reflect::type_id_t id();
+    static std::uint64_t schema();
     static const reflect::meta_t& meta();
     static const char* const name();
     static const reflect::properties_t& properties();
     static std::size_t size();
 
-    static void from_string(const std::string& str, Too& type);
-    static std::string to_string(const Too& type);
+    static void from_string(const std::string& str, Too& type, const reflect::encoding::ByteFormat& format = {});
+    static void from_bytes(const reflect::encoding::ByteView& view, Too& type, const reflect::encoding::ByteFormat& format = {});
+    static void read(reflect::encoding::InputByteStream& stream, Too& type);
+    static void read_body(reflect::encoding::InputByteStream& stream, Too& type);
+    static void read_field(reflect::encoding::InputByteStream& stream, Too& type, const std::uint32_t tag);
+    static std::string to_string(const Too& type, const reflect::encoding::ByteFormat& format = {});
+    static void write(reflect::encoding::OutputByteStream& stream, const Too& type);
+    static std::size_t binary_size(const Too& type, const reflect::encoding::ByteFormat& format = {});
+    static bool write_delta(const Too& baseline, const Too& type, reflect::encoding::OutputByteStream& stream);
+    static void apply_delta(const Too& baseline, reflect::encoding::InputByteStream& stream, Too& type);
     static void from_json(const std::string& json, Too& type);
+    static void read_json(reflect::encoding::json::Reader& reader, Too& type);
     static std::string to_json(const Too& type, const std::string& offset = "");
+    static void to_json(reflect::encoding::json::Writer& writer, const Too& type);
+
+    typedef reflect::encoding::LazyView<Too> LazyView;
+
+    static reflect::encoding::ByteBuffer to_flat(const Too& type);
+    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const Too& type);
+
+    // read-only accessors over a flat buffer
+    struct Flat
+    {
+        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}
+        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}
+
+        bool isValid() const { return m_table.isValid(); }
+
+        reflect::encoding::FlatTable m_table;
+    };
+
+    static bool registered() { return type_registered; };
+};
+
+template <>
+struct reflect::Type<struct Profile> : reflect::RegisteredInTypeFactory<struct Profile>
+{
+    static IType* const instantiate();
+    static std::shared_ptr<IType> instantiate_shared(std::pmr::memory_resource* const resource);
+    static reflect::type_id_t id();
+    static std::uint64_t schema();
+    static const reflect::meta_t& meta();
+    static const char* const name();
+    static const reflect::properties_t& properties();
+    static std::size_t size();
+
+    static void from_string(const std::string& str, Profile& type, const reflect::encoding::ByteFormat& format = {});
+    static void from_bytes(const reflect::encoding::ByteView& view, Profile& type, const reflect::encoding::ByteFormat& format = {});
+    static void read(reflect::encoding::InputByteStream& stream, Profile& type);
+    static void read_body(reflect::encoding::InputByteStream& stream, Profile& type);
+    static void read_field(reflect::encoding::InputByteStream& stream, Profile& type, const std::uint32_t tag);
+    static std::string to_string(const Profile& type, const reflect::encoding::ByteFormat& format = {});
+    static void write(reflect::encoding::OutputByteStream& stream, const Profile& type);
+    static std::size_t binary_size(const Profile& type, const reflect::encoding::ByteFormat& format = {});
+    static bool write_delta(const Profile& baseline, const Profile& type, reflect::encoding::OutputByteStream& stream);
+    static void apply_delta(const Profile& baseline, reflect::encoding::InputByteStream& stream, Profile& type);
+    static void from_json(const std::string& json, Profile& type);
+    static void read_json(reflect::encoding::json::Reader& reader, Profile& type);
+    static std::string to_json(const Profile& type, const std::string& offset = "");
+    static void to_json(reflect::encoding::json::Writer& writer, const Profile& type);
+
+    // dirty bits of the properties
+    struct Dirty
+    {
+        static constexpr std::uint64_t name = reflect::ITrackedType::dirty_bit(0);
+        static constexpr std::uint64_t level = reflect::ITrackedType::dirty_bit(1);
+        static constexpr std::uint64_t items = reflect::ITrackedType::dirty_bit(2);
+    };
+
+    static void set_name(Profile& type, std::string value);
+    static void set_level(Profile& type, int value);
+    static void set_items(Profile& type, std::vector<int> value);
+
+    typedef reflect::encoding::LazyView<Profile> LazyView;
+
+    static reflect::encoding::ByteBuffer to_flat(const Profile& type);
+    static std::size_t write_flat(reflect::encoding::FlatBuilder& builder, const Profile& type);
+
+    // read-only accessors over a flat buffer
+    struct Flat
+    {
+        Flat(const reflect::encoding::FlatTable& table) : m_table{ table } {}
+        Flat(const reflect::encoding::ByteView& view) : m_table{ view } {}
+
+        bool isValid() const { return m_table.isValid(); }
+        std::string_view name() const;
+        int level() const;
+        reflect::encoding::FlatArray<int> items() const;
+
+        reflect::encoding::FlatTable m_table;
+    };
 
     static bool registered() { return type_registered; };
 };
\ No newline at end of file